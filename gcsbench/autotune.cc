@@ -0,0 +1,140 @@
+#include "gcsbench/autotune.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+namespace gcsbench {
+
+std::string TuningConfig::Label() const {
+    return "read=" + FormatSize(read_size) + " buffer=" + (buffer_size == 0 ? std::string("default")
+                                                                            : FormatSize(buffer_size)) +
+           " concurrency=" + std::to_string(concurrency);
+}
+
+bool MeetsSlo(const TuningTrial &trial, double slo_p99_ms) {
+    return !trial.failed && (slo_p99_ms <= 0 || trial.p99_ms <= slo_p99_ms);
+}
+
+bool BetterTrial(const TuningTrial &a, const TuningTrial &b, double slo_p99_ms) {
+    if (a.failed != b.failed) return !a.failed;
+    bool a_meets = MeetsSlo(a, slo_p99_ms);
+    bool b_meets = MeetsSlo(b, slo_p99_ms);
+    if (a_meets != b_meets) return a_meets;
+    if (a_meets) return a.mbs > b.mbs;
+    return a.p99_ms < b.p99_ms;
+}
+
+std::vector<TuningTrial> SuccessiveHalving(const TuningSpace &space,
+                                           const TrialRunner &run,
+                                           std::size_t budget_bytes,
+                                           int eta,
+                                           double slo_p99_ms) {
+    std::vector<TuningConfig> candidates;
+    for (auto read_size : space.read_sizes) {
+        for (auto buffer_size : space.buffer_sizes) {
+            for (auto concurrency : space.concurrency) {
+                candidates.push_back({read_size, buffer_size, concurrency});
+            }
+        }
+    }
+
+    std::vector<TuningTrial> trials;
+    eta = std::max(eta, 2);
+    for (int rung = 0; !candidates.empty(); ++rung) {
+        std::cout << "\n[" << GetTimestamp() << "] Rung " << rung << ": " << candidates.size()
+                  << " configurations, " << FormatSize(budget_bytes) << " each\n";
+        std::vector<TuningTrial> rung_trials;
+        for (const auto &config : candidates) {
+            rung_trials.push_back(run(config, budget_bytes));
+            trials.push_back(rung_trials.back());
+        }
+        std::stable_sort(rung_trials.begin(), rung_trials.end(),
+                         [&](const TuningTrial &a, const TuningTrial &b) { return BetterTrial(a, b, slo_p99_ms); });
+        candidates.clear();
+        if (rung_trials.size() == 1) break;
+        auto keep = std::max<std::size_t>(1, rung_trials.size() / eta);
+        for (std::size_t i = 0; i < keep; ++i) {
+            candidates.push_back(rung_trials[i].config);
+        }
+        budget_bytes *= eta;
+    }
+    return trials;
+}
+
+std::vector<TuningTrial> HillClimb(const TuningSpace &space,
+                                   const TrialRunner &run,
+                                   std::size_t budget_bytes,
+                                   int eta,
+                                   double slo_p99_ms) {
+    using Point = std::array<std::size_t, 3>;
+    const Point sizes = {space.read_sizes.size(), space.buffer_sizes.size(), space.concurrency.size()};
+    std::vector<TuningTrial> trials;
+    if (sizes[0] == 0 || sizes[1] == 0 || sizes[2] == 0) return trials;
+
+    std::map<Point, TuningTrial> measured;
+    auto evaluate = [&](const Point &point) -> const TuningTrial & {
+        auto it = measured.find(point);
+        if (it == measured.end()) {
+            TuningConfig config{space.read_sizes[point[0]], space.buffer_sizes[point[1]],
+                                space.concurrency[point[2]]};
+            trials.push_back(run(config, budget_bytes));
+            it = measured.emplace(point, trials.back()).first;
+        }
+        return it->second;
+    };
+
+    Point current = {sizes[0] / 2, sizes[1] / 2, sizes[2] / 2};
+    for (int step = 0;; ++step) {
+        std::cout << "\n[" << GetTimestamp() << "] Step " << step << ": around "
+                  << evaluate(current).config.Label() << "\n";
+        Point best = current;
+        for (std::size_t dimension = 0; dimension < current.size(); ++dimension) {
+            for (int direction : {-1, 1}) {
+                if ((direction < 0 && current[dimension] == 0) ||
+                    (direction > 0 && current[dimension] + 1 >= sizes[dimension])) {
+                    continue;
+                }
+                Point neighbour = current;
+                neighbour[dimension] += direction;
+                if (BetterTrial(evaluate(neighbour), evaluate(best), slo_p99_ms)) best = neighbour;
+            }
+        }
+        if (best == current) break;
+        current = best;
+    }
+    trials.push_back(run(evaluate(current).config, budget_bytes * std::max(eta, 2)));
+    return trials;
+}
+
+bool AppendTuningResult(const std::string &path,
+                        const std::string &label,
+                        const std::string &client,
+                        const std::string &object_name,
+                        std::size_t object_size,
+                        double slo_p99_ms,
+                        const TuningTrial &best) {
+    std::ofstream out(path, std::ios::app);
+    if (!out) {
+        std::cerr << "Error: cannot open --tune-output " << path << "\n";
+        return false;
+    }
+    auto unix_s = std::chrono::duration_cast<std::chrono::seconds>(
+                      std::chrono::system_clock::now().time_since_epoch()).count();
+    out << "{\"label\":\"" << JsonEscape(label) << "\",\"unix_s\":" << unix_s << ",\"client\":\""
+        << JsonEscape(client) << "\",\"object\":\"" << JsonEscape(object_name) << "\",\"object_size\":" << object_size
+        << ",\"slo_p99_ms\":" << slo_p99_ms << ",\"meets_slo\":" << (MeetsSlo(best, slo_p99_ms) ? "true" : "false")
+        << ",\"read_size\":" << best.config.read_size << ",\"buffer_size\":" << best.config.buffer_size
+        << ",\"concurrency\":" << best.config.concurrency << ",\"mbs\":" << best.mbs << ",\"p50_ms\":"
+        << best.p50_ms << ",\"p99_ms\":" << best.p99_ms << ",\"reads\":" << best.reads << "}\n";
+    if (!out) {
+        std::cerr << "Error: cannot write --tune-output " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+}  // namespace gcsbench
@@ -0,0 +1,81 @@
+#ifndef GCSBENCH_AUTOTUNE_H
+#define GCSBENCH_AUTOTUNE_H
+
+#include "gcsbench/common.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace gcsbench {
+
+// One point of the read configuration space. `buffer_size` is the client's
+// transport buffering: DownloadBufferSizeOption for JSON, the HTTP/2 stream
+// window for gRPC with BDP probing off (0 keeps the library defaults).
+struct TuningConfig {
+    std::size_t read_size = 0;
+    std::size_t buffer_size = 0;
+    int concurrency = 1;
+
+    std::string Label() const;
+};
+
+struct TuningSpace {
+    std::vector<std::size_t> read_sizes;
+    std::vector<std::size_t> buffer_sizes;
+    std::vector<int> concurrency;
+};
+
+struct TuningTrial {
+    TuningConfig config;
+    std::size_t reads = 0;
+    double mbs = 0.0;
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    bool failed = false;
+};
+
+// Measures `config` with about `budget_bytes` of reads.
+using TrialRunner = std::function<TuningTrial(const TuningConfig &config, std::size_t budget_bytes)>;
+
+// Orders trials by the objective: highest throughput among those meeting the
+// p99 SLO (0 disables it), then lowest p99 among those missing it, failed
+// trials last.
+bool BetterTrial(const TuningTrial &a, const TuningTrial &b, double slo_p99_ms);
+
+bool MeetsSlo(const TuningTrial &trial, double slo_p99_ms);
+
+// Successive halving over the whole grid: every configuration gets
+// `budget_bytes`, the best 1/eta go on with eta times the budget, until one
+// is left. Returns every trial run, the last one being the winner's.
+std::vector<TuningTrial> SuccessiveHalving(const TuningSpace &space,
+                                           const TrialRunner &run,
+                                           std::size_t budget_bytes,
+                                           int eta,
+                                           double slo_p99_ms);
+
+// Starts in the middle of every dimension and moves to the best neighbour
+// (one step along one dimension) while that improves the objective, then
+// re-measures the final configuration with `eta` times the budget. Returns
+// every trial run, the last one being the winner's.
+std::vector<TuningTrial> HillClimb(const TuningSpace &space,
+                                   const TrialRunner &run,
+                                   std::size_t budget_bytes,
+                                   int eta,
+                                   double slo_p99_ms);
+
+// Appends the recommendation as one JSON line to `path`, so runs from several
+// regions and machine types accumulate in one file. Returns false (after
+// logging) if the file cannot be written.
+bool AppendTuningResult(const std::string &path,
+                        const std::string &label,
+                        const std::string &client,
+                        const std::string &object_name,
+                        std::size_t object_size,
+                        double slo_p99_ms,
+                        const TuningTrial &best);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_AUTOTUNE_H
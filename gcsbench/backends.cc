@@ -0,0 +1,250 @@
+#include "gcsbench/backends.h"
+
+#include "gcsbench/clients.h"
+#include "gcsbench/http_backends.h"
+#include "gcsbench/transport.h"
+#include "gcsbench/uring_backend.h"
+#include "gcsbench/workloads.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace gcsbench {
+
+namespace {
+
+// ReadObject and GetObject on the generated Storage stub (RawGrpcReader), one
+// reader per bucket over a shared channel. Whole objects are consumed inside
+// the response messages; ranges are copied into the caller's buffer, as
+// ObjectReadStream does.
+class RawGrpcBackend : public StorageBackend {
+public:
+    RawGrpcBackend(std::shared_ptr<grpc::Channel> channel,
+                   RawGrpcReader::MessageMode mode,
+                   std::size_t arena_reset,
+                   bool validate_crc32c)
+        : channel_(std::move(channel)), mode_(mode), arena_reset_(arena_reset), validate_crc32c_(validate_crc32c) {}
+
+    std::string Name() const override { return "raw-grpc"; }
+
+    bool ObjectSize(const std::string &bucket, const std::string &object_name, std::size_t &size) override {
+        return Reader(bucket).ObjectSize(object_name, size);
+    }
+
+    bool ReadObject(const std::string &bucket,
+                    const std::string &object_name,
+                    std::size_t,
+                    std::size_t &bytes_read) override {
+        return Reader(bucket).Read(object_name, 0, 0, mode_, nullptr, 0, bytes_read, arena_reset_);
+    }
+
+    bool ReadRange(const std::string &bucket,
+                   const std::string &object_name,
+                   std::size_t offset,
+                   std::size_t length,
+                   char *buffer,
+                   std::size_t &bytes_read) override {
+        return Reader(bucket).Read(object_name, offset, length, mode_, buffer, length, bytes_read, arena_reset_);
+    }
+
+private:
+    RawGrpcReader &Reader(const std::string &bucket) {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto &reader = readers_[bucket];
+        if (!reader) reader = std::make_unique<RawGrpcReader>(channel_, bucket, validate_crc32c_);
+        return *reader;
+    }
+
+    std::shared_ptr<grpc::Channel> channel_;
+    RawGrpcReader::MessageMode mode_;
+    std::size_t arena_reset_;
+    bool validate_crc32c_;
+    std::mutex mu_;
+    std::map<std::string, std::unique_ptr<RawGrpcReader>> readers_;
+};
+
+std::unique_ptr<StorageBackend> MakeRawGrpcBackend(const BenchmarkFlags &flags) {
+    auto mode_name = GetFlag(flags, "raw-message-mode", "reuse");
+    RawGrpcReader::MessageMode mode;
+    if (mode_name == "fresh") {
+        mode = RawGrpcReader::MessageMode::kFresh;
+    } else if (mode_name == "reuse") {
+        mode = RawGrpcReader::MessageMode::kReuse;
+    } else if (mode_name == "arena") {
+        mode = RawGrpcReader::MessageMode::kArena;
+    } else {
+        std::cerr << "Error: --raw-message-mode must be fresh, reuse or arena\n";
+        return nullptr;
+    }
+    auto channel = MakeRawGrpcChannel(flags);
+    std::size_t arena_reset = std::stoul(GetFlag(flags, "arena-reset", "16"));
+    return std::make_unique<RawGrpcBackend>(std::move(channel), mode, std::max<std::size_t>(arena_reset, 1),
+                                            GetFlag(flags, "raw-crc32c", "true") == "true");
+}
+
+}  // namespace
+
+GcsBackend::GcsBackend(gcs::Client client, std::string name)
+    : client_(std::move(client)), name_(std::move(name)) {}
+
+bool GcsBackend::ObjectSize(const std::string &bucket, const std::string &object_name, std::size_t &size) {
+    auto metadata = client_.GetObjectMetadata(bucket, object_name);
+    if (!metadata) {
+        std::cerr << "Error getting metadata for " << bucket << "/" << object_name << ": " << metadata.status() << "\n";
+        return false;
+    }
+    size = metadata->size();
+    return true;
+}
+
+bool GcsBackend::ReadObject(const std::string &bucket,
+                            const std::string &object_name,
+                            std::size_t buffer_size,
+                            std::size_t &bytes_read) {
+    auto result = SequentialReadBenchmark(client_, bucket, object_name, buffer_size);
+    bytes_read = result.bytes_read;
+    return result.duration_ms != kErrorDuration;
+}
+
+bool GcsBackend::ReadRange(const std::string &bucket,
+                           const std::string &object_name,
+                           std::size_t offset,
+                           std::size_t length,
+                           char *buffer,
+                           std::size_t &bytes_read) {
+    return ReadRangeInto(client_, bucket, object_name, offset, length, buffer, bytes_read);
+}
+
+FileBackend::FileBackend(std::string dir, bool use_mmap) : dir_(std::move(dir)), use_mmap_(use_mmap) {}
+
+FileBackend::~FileBackend() {
+    for (auto &entry : files_) {
+        if (entry.second.data != nullptr) munmap(const_cast<char *>(entry.second.data), entry.second.size);
+        close(entry.second.fd);
+    }
+}
+
+bool FileBackend::Open(const std::string &object_name, OpenFile &file) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = files_.find(object_name);
+    if (it != files_.end()) {
+        file = it->second;
+        return true;
+    }
+
+    auto path = dir_ + "/" + object_name;
+    OpenFile opened;
+    opened.fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat st {};
+    if (opened.fd < 0 || fstat(opened.fd, &st) != 0) {
+        std::cerr << "Error: cannot open " << path << ": " << std::strerror(errno) << "\n";
+        if (opened.fd >= 0) close(opened.fd);
+        return false;
+    }
+    opened.size = static_cast<std::size_t>(st.st_size);
+    if (use_mmap_ && opened.size > 0) {
+        void *data = mmap(nullptr, opened.size, PROT_READ, MAP_SHARED, opened.fd, 0);
+        if (data == MAP_FAILED) {
+            std::cerr << "Error: cannot map " << path << ": " << std::strerror(errno) << "\n";
+            close(opened.fd);
+            return false;
+        }
+        opened.data = static_cast<const char *>(data);
+    }
+    files_[object_name] = opened;
+    file = opened;
+    return true;
+}
+
+bool FileBackend::ObjectSize(const std::string &, const std::string &object_name, std::size_t &size) {
+    OpenFile file;
+    if (!Open(object_name, file)) return false;
+    size = file.size;
+    return true;
+}
+
+bool FileBackend::ReadObject(const std::string &,
+                             const std::string &object_name,
+                             std::size_t buffer_size,
+                             std::size_t &bytes_read) {
+    bytes_read = 0;
+    OpenFile file;
+    if (!Open(object_name, file)) return false;
+    g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+    std::vector<char> buffer(buffer_size);
+    while (bytes_read < file.size) {
+        std::size_t chunk = 0;
+        if (!ReadAt(file, object_name, bytes_read, buffer_size, buffer.data(), chunk)) return false;
+        if (chunk == 0) break;
+        bytes_read += chunk;
+    }
+    return true;
+}
+
+bool FileBackend::ReadRange(const std::string &,
+                            const std::string &object_name,
+                            std::size_t offset,
+                            std::size_t length,
+                            char *buffer,
+                            std::size_t &bytes_read) {
+    bytes_read = 0;
+    OpenFile file;
+    if (!Open(object_name, file)) return false;
+    g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+    return ReadAt(file, object_name, offset, length, buffer, bytes_read);
+}
+
+bool FileBackend::ReadAt(const OpenFile &file,
+                         const std::string &object_name,
+                         std::size_t offset,
+                         std::size_t length,
+                         char *buffer,
+                         std::size_t &bytes_read) {
+    bytes_read = 0;
+    length = offset < file.size ? std::min(length, file.size - offset) : 0;
+    if (file.data != nullptr) {
+        std::memcpy(buffer, file.data + offset, length);
+        bytes_read = length;
+    } else {
+        while (bytes_read < length) {
+            auto n = pread(file.fd, buffer + bytes_read, length - bytes_read, static_cast<off_t>(offset + bytes_read));
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) {
+                std::cerr << "Error reading " << object_name << " at offset " << offset << ": " << std::strerror(errno)
+                          << "\n";
+                return false;
+            }
+            if (n == 0) break;
+            bytes_read += static_cast<std::size_t>(n);
+        }
+    }
+    g_progress.bytes.fetch_add(bytes_read, std::memory_order_relaxed);
+    return true;
+}
+
+std::unique_ptr<StorageBackend> MakeBackend(const std::string &name, const BenchmarkFlags &flags) {
+    if (name == "json") return std::make_unique<GcsBackend>(MakeJsonClient(), "json");
+    if (name == "grpc") return std::make_unique<GcsBackend>(MakeGrpcClient(), "grpc");
+    if (name == "s3") return MakeS3Backend(flags);
+    if (name == "http2") return MakeHttp2Backend(flags);
+    if (name == "raw-curl") return MakeCurlMultiBackend(flags);
+    if (name == "raw-grpc") return MakeRawGrpcBackend(flags);
+    if (name == "uring") return MakeUringBackend(flags);
+    if (name == "file" || name == "mmap") {
+        return std::make_unique<FileBackend>(GetFlag(flags, "local-dir", "."), name == "mmap");
+    }
+    std::cerr << "Error: unknown backend: " << name
+              << " (expected json, grpc, raw-curl, raw-grpc, uring, s3, http2, file or mmap)\n";
+    return nullptr;
+}
+
+}  // namespace gcsbench
@@ -0,0 +1,127 @@
+#ifndef GCSBENCH_BACKENDS_H
+#define GCSBENCH_BACKENDS_H
+
+#include "gcsbench/common.h"
+#include "gcsbench/flags.h"
+
+#include "google/cloud/storage/client.h"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace gcsbench {
+
+// Something the workloads can read objects from. Implementations must allow
+// concurrent calls from several threads, and count the bytes and requests
+// they complete in g_progress like the gcs::Client workloads do.
+class StorageBackend {
+public:
+    virtual ~StorageBackend() = default;
+
+    virtual std::string Name() const = 0;
+
+    // Returns false (after logging) if the size could not be determined.
+    virtual bool ObjectSize(const std::string &bucket, const std::string &object_name, std::size_t &size) = 0;
+
+    // Downloads the whole object through a `buffer_size` buffer.
+    virtual bool ReadObject(const std::string &bucket,
+                            const std::string &object_name,
+                            std::size_t buffer_size,
+                            std::size_t &bytes_read) = 0;
+
+    // Reads [offset, offset + length) into `buffer`.
+    virtual bool ReadRange(const std::string &bucket,
+                           const std::string &object_name,
+                           std::size_t offset,
+                           std::size_t length,
+                           char *buffer,
+                           std::size_t &bytes_read) = 0;
+
+    // Transport counters worth reporting next to the results, if any.
+    virtual void PrintTransportStats() const {}
+};
+
+// The JSON or gRPC client library.
+class GcsBackend : public StorageBackend {
+public:
+    GcsBackend(gcs::Client client, std::string name);
+
+    std::string Name() const override { return name_; }
+    bool ObjectSize(const std::string &bucket, const std::string &object_name, std::size_t &size) override;
+    bool ReadObject(const std::string &bucket,
+                    const std::string &object_name,
+                    std::size_t buffer_size,
+                    std::size_t &bytes_read) override;
+    bool ReadRange(const std::string &bucket,
+                   const std::string &object_name,
+                   std::size_t offset,
+                   std::size_t length,
+                   char *buffer,
+                   std::size_t &bytes_read) override;
+
+private:
+    gcs::Client client_;
+    std::string name_;
+};
+
+// Local copies of the objects, `<dir>/<object>` (the bucket is ignored). Reads
+// go through pread(), or through a shared read-only mapping with `use_mmap`.
+// Both are served from the page cache after the first pass, which makes them
+// a lower bound for what any network client can achieve.
+class FileBackend : public StorageBackend {
+public:
+    FileBackend(std::string dir, bool use_mmap);
+    ~FileBackend() override;
+
+    FileBackend(const FileBackend &) = delete;
+    FileBackend &operator=(const FileBackend &) = delete;
+
+    std::string Name() const override { return use_mmap_ ? "mmap" : "file"; }
+    bool ObjectSize(const std::string &bucket, const std::string &object_name, std::size_t &size) override;
+    bool ReadObject(const std::string &bucket,
+                    const std::string &object_name,
+                    std::size_t buffer_size,
+                    std::size_t &bytes_read) override;
+    bool ReadRange(const std::string &bucket,
+                   const std::string &object_name,
+                   std::size_t offset,
+                   std::size_t length,
+                   char *buffer,
+                   std::size_t &bytes_read) override;
+
+private:
+    struct OpenFile {
+        int fd = -1;
+        std::size_t size = 0;
+        const char *data = nullptr;  // mapping, only with use_mmap_
+    };
+
+    // Opens (and maps) each file once; later calls reuse it.
+    bool Open(const std::string &object_name, OpenFile &file);
+
+    // Copies [offset, offset + length) of `file`, clamped to its size.
+    bool ReadAt(const OpenFile &file,
+                const std::string &object_name,
+                std::size_t offset,
+                std::size_t length,
+                char *buffer,
+                std::size_t &bytes_read);
+
+    std::string dir_;
+    bool use_mmap_;
+    std::mutex mu_;
+    std::map<std::string, OpenFile> files_;
+};
+
+// Backend names accepted by MakeBackend: json, grpc, raw-curl, raw-grpc, uring,
+// s3, http2, file, mmap.
+// Backend-specific settings come from `flags` (see README). Returns nullptr
+// (after logging) for an unknown name or incomplete settings.
+std::unique_ptr<StorageBackend> MakeBackend(const std::string &name, const BenchmarkFlags &flags);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_BACKENDS_H
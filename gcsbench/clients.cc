@@ -0,0 +1,185 @@
+#include "gcsbench/clients.h"
+
+#include "gcsbench/crc32c.h"
+#include "gcsbench/transport.h"
+
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/storage/async/client.h"
+
+namespace gcsbench {
+
+gcs::Client MakeTunedJsonClient(const JsonTransportConfig &config) {
+    auto options = gc::Options{}
+                       .set<gcs::ConnectionPoolSizeOption>(config.connection_pool_size)
+                       .set<gcs::DownloadBufferSizeOption>(config.download_buffer_size)
+                       .set<gcs_ex::HttpVersionOption>(config.http_version);
+    if (config.socket_buffer_size != 0) {
+        options.set<gcs::MaximumCurlSocketRecvSizeOption>(config.socket_buffer_size)
+            .set<gcs::MaximumCurlSocketSendSizeOption>(config.socket_buffer_size);
+    }
+    return MakeJsonClient(options);
+}
+
+grpc::ChannelArguments GrpcFlowControlArguments(const GrpcTransportConfig &config) {
+    grpc::ChannelArguments args;
+    if (config.window_size != 0) {
+        args.SetInt(GRPC_ARG_HTTP2_STREAM_LOOKAHEAD_BYTES, static_cast<int>(config.window_size));
+    }
+    if (!config.bdp_probe.empty()) args.SetInt(GRPC_ARG_HTTP2_BDP_PROBE, config.bdp_probe == "on" ? 1 : 0);
+    if (config.max_receive_message_size != 0) {
+        args.SetMaxReceiveMessageSize(static_cast<int>(config.max_receive_message_size));
+    }
+    return args;
+}
+
+gcs::Client MakeTunedGrpcClient(const GrpcTransportConfig &config) {
+    // Setting the option, even to empty arguments, would hide the --grpc-*
+    // flow-control flags from MakeGrpcClient.
+    if (config.IsDefault()) return MakeGrpcClient();
+    return MakeGrpcClient(gc::Options{}.set<gc::GrpcChannelArgumentsNativeOption>(GrpcFlowControlArguments(config)));
+}
+
+std::string RoutingBucketParam(const std::string &bucket) {
+    return "bucket=projects%2F_%2Fbuckets%2F" + bucket;
+}
+
+std::string RawGrpcTarget(const BenchmarkFlags &flags) {
+    return GetFlag(flags, "raw-endpoint", SelectedTransport().GrpcTarget());
+}
+
+std::shared_ptr<grpc::Channel> MakeRawGrpcChannel(const BenchmarkFlags &flags) {
+    const auto &selection = SelectedTransport();
+    auto target = RawGrpcTarget(flags);
+    grpc::ChannelArguments args;
+    args.SetMaxReceiveMessageSize(-1);
+    if (target == selection.GrpcTarget() && selection.grpc_path == "direct" && selection.grpc_endpoint.empty()) {
+        args.SetString(GRPC_ARG_DEFAULT_AUTHORITY, "storage.googleapis.com");
+    }
+    auto credentials = GetFlag(flags, "raw-insecure", "false") == "true" ? grpc::InsecureChannelCredentials()
+                                                                         : SelectedGrpcCredentials();
+    return grpc::CreateCustomChannel(target, credentials, args);
+}
+
+bool RawGrpcReader::Read(const std::string &object_name,
+                         std::size_t offset,
+                         std::size_t length,
+                         MessageMode mode,
+                         char *copy_to,
+                         std::size_t copy_capacity,
+                         std::size_t &bytes_read,
+                         std::size_t arena_reset_messages) {
+    bytes_read = 0;
+    storage_v2::ReadObjectRequest request;
+    request.set_bucket("projects/_/buckets/" + bucket_);
+    request.set_object(object_name);
+    request.set_read_offset(offset);
+    request.set_read_limit(length);
+
+    grpc::ClientContext context;
+    context.AddMetadata("x-goog-request-params", RoutingBucketParam(bucket_));
+    auto reader = stub_->ReadObject(&context, request);
+
+    std::size_t copy_position = 0;
+    auto sink = [&](const char *data, std::size_t size) {
+        bytes_read += size;
+        g_progress.bytes.fetch_add(size, std::memory_order_relaxed);
+        while (copy_to != nullptr && size > 0) {
+            auto n = std::min(size, copy_capacity - copy_position);
+            std::memcpy(copy_to + copy_position, data, n);
+            copy_position = (copy_position + n) % copy_capacity;
+            data += n;
+            size -= n;
+        }
+    };
+
+    // One CRC32C pass per message, combined into the object's running CRC.
+    bool checksums_ok = true;
+    bool has_object_crc32c = false;
+    uint32_t object_crc32c = 0;
+    uint32_t running_crc32c = 0;
+    auto consume = [&](const storage_v2::ReadObjectResponse &response) {
+        const auto &data = response.checksummed_data();
+        if (validate_crc32c_) {
+            uint32_t crc = 0;
+            std::size_t size = 0;
+            VisitContent(data.content(), [&](const char *chunk, std::size_t chunk_size) {
+                crc = Crc32cExtend(crc, chunk, chunk_size);
+                size += chunk_size;
+            });
+            if (data.has_crc32c() && data.crc32c() != crc) checksums_ok = false;
+            running_crc32c = Crc32cConcat(running_crc32c, crc, size);
+            if (response.has_object_checksums() && response.object_checksums().has_crc32c()) {
+                has_object_crc32c = true;
+                object_crc32c = response.object_checksums().crc32c();
+            }
+        }
+        VisitContent(data.content(), sink);
+    };
+
+    switch (mode) {
+    case MessageMode::kFresh:
+        for (;;) {
+            storage_v2::ReadObjectResponse response;
+            if (!reader->Read(&response)) break;
+            consume(response);
+        }
+        break;
+    case MessageMode::kReuse: {
+        storage_v2::ReadObjectResponse response;
+        while (reader->Read(&response)) {
+            consume(response);
+        }
+        break;
+    }
+    case MessageMode::kArena: {
+        // Per thread, so concurrent reads never share an initial block.
+        thread_local std::vector<char> arena_block(8 * kMiB);
+        google::protobuf::ArenaOptions options;
+        options.initial_block = arena_block.data();
+        options.initial_block_size = arena_block.size();
+        google::protobuf::Arena arena(options);
+        for (std::size_t messages = 1;; ++messages) {
+            auto *response = google::protobuf::Arena::Create<storage_v2::ReadObjectResponse>(&arena);
+            if (!reader->Read(response)) break;
+            consume(*response);
+            if (messages % arena_reset_messages == 0) arena.Reset();
+        }
+        break;
+    }
+    }
+
+    auto status = reader->Finish();
+    g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+    if (!status.ok()) {
+        std::cerr << "Error during raw ReadObject at offset " << offset << ": " << status.error_message()
+                  << " (" << status.error_code() << ")\n";
+        return false;
+    }
+    // The object's CRC32C only covers a read of the whole object.
+    if (offset == 0 && length == 0 && has_object_crc32c && object_crc32c != running_crc32c) checksums_ok = false;
+    if (!checksums_ok) {
+        std::cerr << "Error during raw ReadObject at offset " << offset << ": CRC32C mismatch\n";
+        return false;
+    }
+    return true;
+}
+
+bool RawGrpcReader::ObjectSize(const std::string &object_name, std::size_t &size) {
+    storage_v2::GetObjectRequest request;
+    request.set_bucket("projects/_/buckets/" + bucket_);
+    request.set_object(object_name);
+
+    grpc::ClientContext context;
+    context.AddMetadata("x-goog-request-params", RoutingBucketParam(bucket_));
+    storage_v2::Object object;
+    auto status = stub_->GetObject(&context, request, &object);
+    if (!status.ok()) {
+        std::cerr << "Error during raw GetObject for " << object_name << ": " << status.error_message() << " ("
+                  << status.error_code() << ")\n";
+        return false;
+    }
+    size = static_cast<std::size_t>(object.size());
+    return true;
+}
+
+}  // namespace gcsbench
@@ -0,0 +1,115 @@
+#ifndef GCSBENCH_CLIENTS_H
+#define GCSBENCH_CLIENTS_H
+
+#include "gcsbench/common.h"
+#include "gcsbench/transport.h"
+
+#include "absl/strings/cord.h"
+#include "google/cloud/storage/client.h"
+#include "google/storage/v2/storage.grpc.pb.h"
+#include <google/protobuf/arena.h>
+#include <grpcpp/grpcpp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gcsbench {
+
+struct JsonTransportConfig {
+    std::size_t connection_pool_size;
+    std::size_t download_buffer_size;
+    std::string http_version;
+    std::size_t socket_buffer_size;  // 0 keeps the OS default
+
+    std::string Label() const {
+        return "pool=" + std::to_string(connection_pool_size) +
+               " dlbuf=" + FormatSize(download_buffer_size) +
+               " http=" + http_version +
+               " sockbuf=" + (socket_buffer_size == 0 ? std::string("default") : FormatSize(socket_buffer_size));
+    }
+};
+
+gcs::Client MakeTunedJsonClient(const JsonTransportConfig &config);
+
+grpc::ChannelArguments GrpcFlowControlArguments(const GrpcTransportConfig &config);
+
+// A gRPC client with `config` in place of the selected flow control; a
+// default `config` keeps the selected flow control.
+gcs::Client MakeTunedGrpcClient(const GrpcTransportConfig &config);
+
+namespace storage_v2 = ::google::storage::v2;
+
+// Hands the bytes of a ReadObjectResponse to `sink` without copying them out
+// of the message. Depending on how the protos were generated the content is
+// either a std::string or an absl::Cord.
+template <typename Sink>
+void VisitContent(const std::string &content, Sink &&sink) {
+    sink(content.data(), content.size());
+}
+
+template <typename Sink>
+void VisitContent(const absl::Cord &content, Sink &&sink) {
+    for (auto chunk : content.Chunks()) {
+        sink(chunk.data(), chunk.size());
+    }
+}
+
+std::string RoutingBucketParam(const std::string &bucket);
+
+// ReadObject driver on the generated Storage stub, bypassing the client
+// library, to measure what protobuf parsing and allocation cost the stock
+// gRPC reader. Like the stock reader it validates each message's CRC32C and,
+// for whole-object reads, the object's; `validate_crc32c` false skips both.
+class RawGrpcReader {
+public:
+    enum class MessageMode {
+        kFresh,  // a new response message per chunk
+        kReuse,  // one response message, re-parsed in place
+        kArena,  // responses allocated on an arena that is reset periodically
+    };
+
+    RawGrpcReader(std::shared_ptr<grpc::Channel> channel, std::string bucket, bool validate_crc32c = true)
+        : stub_(storage_v2::Storage::NewStub(std::move(channel))),
+          bucket_(std::move(bucket)),
+          validate_crc32c_(validate_crc32c) {}
+
+    // Reads `length` bytes at `offset` (the rest of the object if 0). With a
+    // non-null `copy_to` the content is copied into it, wrapping around at
+    // `copy_capacity` like a caller's read buffer would be refilled;
+    // otherwise it is only consumed in place.
+    bool Read(const std::string &object_name,
+              std::size_t offset,
+              std::size_t length,
+              MessageMode mode,
+              char *copy_to,
+              std::size_t copy_capacity,
+              std::size_t &bytes_read,
+              std::size_t arena_reset_messages = 16);
+
+    // Object size from a GetObject RPC.
+    bool ObjectSize(const std::string &object_name, std::size_t &size);
+
+private:
+    std::unique_ptr<storage_v2::Storage::Stub> stub_;
+    std::string bucket_;
+    bool validate_crc32c_;
+};
+
+// The raw stub reader's target: --raw-endpoint, or else the gRPC client's
+// selected target (emulator included), so both read from the same service.
+std::string RawGrpcTarget(const BenchmarkFlags &flags);
+
+// A channel to RawGrpcTarget() with no receive size limit. It uses the gRPC
+// client's credentials, or none with --raw-insecure=true.
+std::shared_ptr<grpc::Channel> MakeRawGrpcChannel(const BenchmarkFlags &flags);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_CLIENTS_H
@@ -0,0 +1,96 @@
+#include "gcsbench/common.h"
+
+#include <time.h>
+
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <new>
+#include <sstream>
+
+namespace gcsbench {
+
+ProgressCounters g_progress;
+
+AllocationCounters g_allocations;
+
+double ProcessCpuTimeMs() {
+    timespec ts{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1.0e6;
+}
+
+double ThreadCpuTimeMs() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1.0e6;
+}
+
+std::string GetTimestamp() {
+    auto system_now = std::chrono::system_clock::now();
+    std::time_t now_c = std::chrono::system_clock::to_time_t(system_now);
+    char time_buf[80];
+    if (std::strftime(time_buf, sizeof(time_buf), "%Y-%m-%d %H:%M:%S", std::localtime(&now_c)) == 0) {
+         return "Timestamp Error";
+    }
+    return std::string(time_buf);
+}
+
+std::string JsonEscape(const std::string &value) {
+    std::ostringstream os;
+    for (unsigned char c : value) {
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if (c < 0x20) {
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+               << std::setfill(' ');
+        } else {
+            os << c;
+        }
+    }
+    return os.str();
+}
+
+std::string FormatSize(std::size_t bytes) {
+    if (bytes != 0 && bytes % kMiB == 0) return std::to_string(bytes / kMiB) + "MiB";
+    if (bytes != 0 && bytes % kKiB == 0) return std::to_string(bytes / kKiB) + "KiB";
+    return std::to_string(bytes);
+}
+
+}  // namespace gcsbench
+
+#ifdef GCS_BENCHMARK_COUNT_ALLOCATIONS
+namespace {
+
+void *CountedAllocate(std::size_t size, std::size_t alignment = 0) {
+    gcsbench::g_allocations.allocations.fetch_add(1, std::memory_order_relaxed);
+    gcsbench::g_allocations.bytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    if (alignment <= alignof(std::max_align_t)) return std::malloc(size);
+    void *p = nullptr;
+    return posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+}
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+    if (auto *p = CountedAllocate(size)) return p;
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t size) { return operator new(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return CountedAllocate(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return CountedAllocate(size); }
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    if (auto *p = CountedAllocate(size, static_cast<std::size_t>(alignment))) return p;
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+#endif
@@ -0,0 +1,67 @@
+#ifndef GCSBENCH_COMMON_H
+#define GCSBENCH_COMMON_H
+
+#include "google/cloud/storage/async/client.h"
+#include "google/cloud/storage/client.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gcsbench {
+
+namespace gcs = google::cloud::storage;
+namespace gc = ::google::cloud;
+namespace gcs_ex = ::google::cloud::storage_experimental;
+
+using BenchmarkClock = std::chrono::high_resolution_clock;
+
+constexpr std::size_t kKiB = 1024;
+constexpr std::size_t kMiB = 1024 * kKiB;
+constexpr std::size_t kDefaultBufferSize = 4 * kMiB;
+// Reads through the client libraries publish progress at least this often,
+// so a timeline interval shorter than one read still sees its bytes.
+constexpr std::size_t kProgressChunkSize = 256 * kKiB;
+constexpr int kErrorDuration = -1;
+
+struct BenchmarkResult {
+    int64_t duration_ms = kErrorDuration;
+    size_t bytes_read = 0;
+};
+
+// Bytes and requests completed by the workloads, sampled by TimelineRecorder.
+struct ProgressCounters {
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> requests{0};
+};
+
+extern ProgressCounters g_progress;
+
+// Counts every C++ heap allocation in the process (the global operator new
+// replaced in common.cc serves the client libraries too). C allocations made
+// by gRPC core and libcurl show up in the allocator stats.
+struct AllocationCounters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+extern AllocationCounters g_allocations;
+
+// CPU time consumed by all threads of the process, including the client
+// libraries' background threads.
+double ProcessCpuTimeMs();
+
+double ThreadCpuTimeMs();
+
+std::string GetTimestamp();
+
+std::string FormatSize(std::size_t bytes);
+
+// Escapes `value` for use inside a JSON string literal.
+std::string JsonEscape(const std::string &value);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_COMMON_H
@@ -0,0 +1,85 @@
+#include "gcsbench/crc32c.h"
+
+#include "absl/crc/crc32c.h"
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+#include <array>
+#include <cstring>
+
+namespace gcsbench {
+
+namespace {
+
+constexpr uint32_t kCrc32cPolynomial = 0x82F63B78;
+
+const std::array<std::array<uint32_t, 256>, 8> &Crc32cTables() {
+    static const auto tables = [] {
+        std::array<std::array<uint32_t, 256>, 8> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int k = 0; k < 8; ++k) {
+                crc = (crc >> 1) ^ ((crc & 1) ? kCrc32cPolynomial : 0);
+            }
+            t[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int k = 1; k < 8; ++k) {
+                t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+            }
+        }
+        return t;
+    }();
+    return tables;
+}
+
+}  // namespace
+
+uint32_t Crc32cTable(const char *data, std::size_t size) {
+    const auto &t = Crc32cTables();
+    auto p = reinterpret_cast<const unsigned char *>(data);
+    uint32_t crc = 0xFFFFFFFF;
+    for (; size >= 8; size -= 8, p += 8) {
+        uint32_t lo = crc ^ (p[0] | p[1] << 8 | p[2] << 16 | static_cast<uint32_t>(p[3]) << 24);
+        uint32_t hi = p[4] | p[5] << 8 | p[6] << 16 | static_cast<uint32_t>(p[7]) << 24;
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+              t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+    }
+    for (; size > 0; --size, ++p) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFF];
+    }
+    return ~crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2")))
+uint32_t Crc32cSse42(const char *data, std::size_t size) {
+    uint64_t crc = 0xFFFFFFFF;
+    for (; size >= 8; size -= 8, data += 8) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u64(crc, word);
+    }
+    auto crc32 = static_cast<uint32_t>(crc);
+    for (; size > 0; --size, ++data) {
+        crc32 = _mm_crc32_u8(crc32, static_cast<unsigned char>(*data));
+    }
+    return ~crc32;
+}
+#endif
+
+uint32_t Crc32cAbsl(const char *data, std::size_t size) {
+    return static_cast<uint32_t>(absl::ComputeCrc32c(absl::string_view(data, size)));
+}
+
+uint32_t Crc32cExtend(uint32_t crc, const char *data, std::size_t size) {
+    return static_cast<uint32_t>(absl::ExtendCrc32c(absl::crc32c_t{crc}, absl::string_view(data, size)));
+}
+
+uint32_t Crc32cConcat(uint32_t crc, uint32_t next_crc, std::size_t next_size) {
+    return static_cast<uint32_t>(absl::ConcatCrc32c(absl::crc32c_t{crc}, absl::crc32c_t{next_crc}, next_size));
+}
+
+}  // namespace gcsbench
@@ -0,0 +1,31 @@
+#ifndef GCSBENCH_CRC32C_H
+#define GCSBENCH_CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gcsbench {
+
+// CRC32C (Castagnoli) kernels used to estimate what hash validation costs per
+// byte read. All of them must agree with absl::ComputeCrc32c, which is what
+// the client library uses.
+
+// Portable slicing-by-8 implementation.
+uint32_t Crc32cTable(const char *data, std::size_t size);
+
+#if defined(__x86_64__)
+// Single-stream SSE4.2 crc32 instruction, 8 bytes per step.
+uint32_t Crc32cSse42(const char *data, std::size_t size);
+#endif
+
+uint32_t Crc32cAbsl(const char *data, std::size_t size);
+
+// `crc` extended over `size` more bytes, and the CRC of two adjacent ranges
+// from theirs, so chunked content is only hashed once (absl).
+uint32_t Crc32cExtend(uint32_t crc, const char *data, std::size_t size);
+
+uint32_t Crc32cConcat(uint32_t crc, uint32_t next_crc, std::size_t next_size);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_CRC32C_H
@@ -0,0 +1,286 @@
+#include "gcsbench/executors.h"
+
+#include "gcsbench/memory.h"
+#include "gcsbench/reporters.h"
+#include "gcsbench/timeline.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace gcsbench {
+
+namespace {
+
+std::string SanitizeLabel(std::string label) {
+    for (auto &c : label) {
+        if (!std::isalnum(static_cast<unsigned char>(c))) c = '_';
+    }
+    return label;
+}
+
+// Writes the timeline as CSV to `<dir>/<label>.csv` and prints its
+// steady-state summary, appending the steady-state throughput to `steady_mbs`.
+void ReportTimeline(const PhaseInstrumentation &instrumentation,
+                    const std::string &label,
+                    const std::vector<TimelineSample> &samples,
+                    std::vector<double> &steady_mbs) {
+    auto path = instrumentation.timeline_dir + "/" + SanitizeLabel(label) + ".csv";
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Error: cannot write timeline " << path << "\n";
+    } else {
+        out << "elapsed_ms,bytes,requests,mb_per_s\n";
+        double previous_ms = 0.0;
+        for (const auto &sample : samples) {
+            double interval_s = std::max(sample.elapsed_ms - previous_ms, 1e-3) / 1000.0;
+            out << sample.elapsed_ms << "," << sample.bytes << "," << sample.requests << ","
+                << sample.bytes / static_cast<double>(kMiB) / interval_s << "\n";
+            previous_ms = sample.elapsed_ms;
+        }
+    }
+
+    if (samples.empty()) return;
+    auto state = DetectSteadyState(samples);
+    double window_start_ms = state.first == 0 ? 0.0 : samples[state.first - 1].elapsed_ms;
+    std::cout << "    steady state " << window_start_ms << "-" << samples[state.last].elapsed_ms << " ms: "
+              << state.throughput_mbs << " MB/s, " << state.stalls << " stalled intervals ("
+              << state.stall_ms << " ms)\n";
+    steady_mbs.push_back(state.throughput_mbs);
+}
+
+}  // namespace
+
+AggregateStats RunSequentialBenchmark(int num_iterations, StorageBackend &backend,
+                         const std::string &bucket,
+                         const std::string &object_name,
+                         const std::string &tag,
+                         const PhaseInstrumentation &instrumentation) {
+    size_t file_size_bytes = 0;
+    if (!backend.ObjectSize(bucket, object_name, file_size_bytes)) {
+         return {};
+    }
+
+    std::cout << "\n" << tag << "\n==== Sequentially reading " << bucket << "/" << object_name
+              << " (" << file_size_bytes / static_cast<double>(kMiB) << " MB)"
+              << " Buffer size: " << kDefaultBufferSize / kKiB << " KB ====\n";
+
+    std::vector<int64_t> durations;
+    durations.reserve(num_iterations);
+
+    std::vector<double> steady_mbs;
+    bool record_timeline = !instrumentation.timeline_dir.empty();
+    TimelineRecorder recorder(instrumentation.timeline_interval);
+    MemorySampler memory;
+    std::size_t phase_bytes = 0;
+    // Started before the memory sampler so the profiler's setup (and perf's
+    // attach delay) is not counted in the phase.
+    ScopedPhaseProfile profile(instrumentation.profiler, SanitizeLabel("sequential_" + tag));
+    if (instrumentation.sample_memory) memory.Start();
+
+    for (int i = 1; i <= num_iterations; ++i) {
+        if (record_timeline) recorder.Start();
+        auto result = SequentialReadBenchmark(backend, bucket, object_name, kDefaultBufferSize);
+        phase_bytes += result.bytes_read;
+        auto samples = recorder.Stop();
+         std::cout << "[" << GetTimestamp() << "] Iteration " << i << ": ";
+        if (result.duration_ms != kErrorDuration) {
+            std::cout << result.bytes_read / kMiB << " MB in " << result.duration_ms << " ms\n";
+            durations.push_back(result.duration_ms);
+        } else {
+            std::cout << "Failed.\n";
+        }
+        if (record_timeline) {
+            ReportTimeline(instrumentation, "sequential_" + tag + "_" + std::to_string(i), samples, steady_mbs);
+        }
+    }
+
+    auto memory_summary = memory.Stop();
+    auto stats = PrintAggregateResults("Sequential (" + tag + ")", num_iterations, file_size_bytes, 0, durations);
+    PrintSteadyStateSummary(steady_mbs);
+    if (instrumentation.sample_memory) PrintMemorySummary(memory_summary, phase_bytes);
+    return stats;
+}
+
+AggregateStats RunRandomBenchmark(int num_iterations, StorageBackend &backend,
+                     const std::string &bucket,
+                     const std::string &object_name,
+                     std::size_t read_size,
+                     const std::string &tag,
+                     int concurrency,
+                     const PhaseInstrumentation &instrumentation) {
+    size_t file_size_bytes = 0;
+    if (!backend.ObjectSize(bucket, object_name, file_size_bytes)) {
+         return {};
+    }
+
+    std::cout << "\n" << tag << "\n==== Random reading " << bucket << "/" << object_name
+              << " (" << file_size_bytes / static_cast<double>(kMiB) << " MB)"
+              << " Read size: " << read_size / kKiB << " KB"
+              << " Concurrency: " << concurrency << " ====\n";
+
+    std::vector<int64_t> durations;
+    durations.reserve(num_iterations);
+
+    std::vector<double> steady_mbs;
+    bool record_timeline = !instrumentation.timeline_dir.empty();
+    TimelineRecorder recorder(instrumentation.timeline_interval);
+    MemorySampler memory;
+    std::size_t phase_bytes = 0;
+    ScopedPhaseProfile profile(instrumentation.profiler,
+                               SanitizeLabel("random_" + FormatSize(read_size) + "_" + tag));
+    if (instrumentation.sample_memory) memory.Start();
+
+    for (int i = 1; i <= num_iterations; ++i) {
+        if (record_timeline) recorder.Start();
+        auto result = concurrency > 1
+                          ? ConcurrentRandomReadBenchmark(backend, bucket, object_name, file_size_bytes, read_size, concurrency)
+                          : RandomReadBenchmark(backend, bucket, object_name, file_size_bytes, read_size);
+        phase_bytes += result.bytes_read;
+        auto samples = recorder.Stop();
+        std::cout << "[" << GetTimestamp() << "] Iteration " << i << ": ";
+        if (result.duration_ms != kErrorDuration) {
+            std::cout << result.bytes_read / kMiB << " MB in " << result.duration_ms << " ms\n";
+            durations.push_back(result.duration_ms);
+        } else {
+             std::cout << "Failed. Read " << result.bytes_read / static_cast<double>(kMiB) << " MB before failure.\n";
+        }
+        if (record_timeline) {
+            ReportTimeline(instrumentation, "random_" + FormatSize(read_size) + "_" + tag + "_" + std::to_string(i),
+                           samples, steady_mbs);
+        }
+    }
+
+    auto memory_summary = memory.Stop();
+    auto stats = PrintAggregateResults("Random (" + tag + ")", num_iterations, file_size_bytes, read_size, durations);
+    PrintSteadyStateSummary(steady_mbs);
+    if (instrumentation.sample_memory) PrintMemorySummary(memory_summary, phase_bytes);
+    return stats;
+}
+
+AggregateStats RunSequentialBenchmark(int num_iterations, gcs::Client &client,
+                         const std::string &bucket,
+                         const std::string &object_name,
+                         const std::string &tag,
+                         const PhaseInstrumentation &instrumentation) {
+    GcsBackend backend(client, tag);
+    return RunSequentialBenchmark(num_iterations, backend, bucket, object_name, tag, instrumentation);
+}
+
+AggregateStats RunRandomBenchmark(int num_iterations, gcs::Client &client,
+                     const std::string &bucket,
+                     const std::string &object_name,
+                     std::size_t read_size,
+                     const std::string &tag,
+                     int concurrency,
+                     const PhaseInstrumentation &instrumentation) {
+    GcsBackend backend(client, tag);
+    return RunRandomBenchmark(num_iterations, backend, bucket, object_name, read_size, tag, concurrency,
+                              instrumentation);
+}
+
+OpenLoopResult RunOpenLoop(gcs::Client &client,
+                           const std::string &bucket,
+                           const std::vector<ScheduledRead> &schedule,
+                           int concurrency) {
+    OpenLoopResult result;
+    result.latencies_ms.assign(schedule.size(), 0.0);
+    result.service_ms.assign(schedule.size(), 0.0);
+    std::vector<char> succeeded(schedule.size(), 0);
+
+    std::atomic<std::size_t> next_request{0};
+    std::atomic<std::size_t> total_bytes_read{0};
+    auto run_start = BenchmarkClock::now();
+
+    auto worker = [&] {
+        std::vector<char> buffer;
+        for (auto i = next_request++; i < schedule.size(); i = next_request++) {
+            const auto &request = schedule[i];
+            auto intended_start = run_start + request.start;
+            std::this_thread::sleep_until(intended_start);
+            auto actual_start = BenchmarkClock::now();
+
+            buffer.resize(std::max(buffer.size(), request.length));
+            std::size_t bytes_read = 0;
+            bool ok = ReadRangeInto(client, bucket, request.object_name, request.offset, request.length,
+                                    buffer.data(), bytes_read);
+            auto end_time = BenchmarkClock::now();
+
+            total_bytes_read += bytes_read;
+            succeeded[i] = ok;
+            result.latencies_ms[i] = std::chrono::duration<double, std::milli>(end_time - intended_start).count();
+            result.service_ms[i] = std::chrono::duration<double, std::milli>(end_time - actual_start).count();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(concurrency);
+    for (int i = 0; i < concurrency; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto &t : workers) {
+        t.join();
+    }
+    result.duration_s = std::chrono::duration<double>(BenchmarkClock::now() - run_start).count();
+    result.bytes_read = total_bytes_read;
+
+    // Failed requests do not contribute latency samples.
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < schedule.size(); ++i) {
+        if (!succeeded[i]) {
+            ++result.failures;
+            continue;
+        }
+        result.latencies_ms[kept] = result.latencies_ms[i];
+        result.service_ms[kept] = result.service_ms[i];
+        ++kept;
+    }
+    result.latencies_ms.resize(kept);
+    result.service_ms.resize(kept);
+    return result;
+}
+
+BenchmarkResult RunRangeReads(const std::vector<std::pair<std::size_t, std::size_t>> &ranges,
+                              int concurrency,
+                              const RangeReader &read_range,
+                              std::vector<double> &latencies_ms) {
+    BenchmarkResult result;
+    std::vector<double> latencies(ranges.size(), 0.0);
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> total_bytes_read{0};
+    std::atomic<bool> failed{false};
+
+    auto worker = [&] {
+        std::vector<char> buffer;
+        for (auto i = next++; i < ranges.size() && !failed; i = next++) {
+            buffer.resize(std::max(buffer.size(), ranges[i].second));
+            std::size_t bytes_read = 0;
+            auto start = BenchmarkClock::now();
+            if (!read_range(ranges[i].first, ranges[i].second, buffer.data(), bytes_read)) {
+                failed = true;
+            }
+            latencies[i] = std::chrono::duration<double, std::milli>(BenchmarkClock::now() - start).count();
+            total_bytes_read += bytes_read;
+        }
+    };
+
+    auto start_time = BenchmarkClock::now();
+    std::vector<std::thread> workers;
+    for (int i = 0; i < std::max(concurrency, 1); ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto &t : workers) {
+        t.join();
+    }
+    result.bytes_read = total_bytes_read;
+    if (failed) return result;
+    result.duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(BenchmarkClock::now() - start_time).count();
+    latencies_ms.insert(latencies_ms.end(), latencies.begin(), latencies.end());
+    return result;
+}
+
+}  // namespace gcsbench
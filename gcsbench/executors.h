@@ -0,0 +1,84 @@
+#ifndef GCSBENCH_EXECUTORS_H
+#define GCSBENCH_EXECUTORS_H
+
+#include "gcsbench/backends.h"
+#include "gcsbench/common.h"
+#include "gcsbench/profiler.h"
+#include "gcsbench/stats.h"
+#include "gcsbench/workloads.h"
+
+#include "google/cloud/storage/client.h"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gcsbench {
+
+// Instrumentation applied around each iteration of the Run*Benchmark phases.
+struct PhaseInstrumentation {
+    std::string timeline_dir;  // empty disables timeline recording
+    std::chrono::milliseconds timeline_interval{100};
+    bool sample_memory = false;
+    ProfilerOptions profiler;
+};
+
+AggregateStats RunSequentialBenchmark(int num_iterations, gcs::Client &client,
+                         const std::string &bucket,
+                         const std::string &object_name,
+                         const std::string &tag,
+                         const PhaseInstrumentation &instrumentation = {});
+
+AggregateStats RunRandomBenchmark(int num_iterations, gcs::Client &client,
+                     const std::string &bucket,
+                     const std::string &object_name,
+                     std::size_t read_size,
+                     const std::string &tag,
+                     int concurrency = 1,
+                     const PhaseInstrumentation &instrumentation = {});
+
+// The same phases on any StorageBackend; the gcs::Client overloads above wrap
+// the client in a GcsBackend.
+AggregateStats RunSequentialBenchmark(int num_iterations, StorageBackend &backend,
+                         const std::string &bucket,
+                         const std::string &object_name,
+                         const std::string &tag,
+                         const PhaseInstrumentation &instrumentation = {});
+
+AggregateStats RunRandomBenchmark(int num_iterations, StorageBackend &backend,
+                     const std::string &bucket,
+                     const std::string &object_name,
+                     std::size_t read_size,
+                     const std::string &tag,
+                     int concurrency = 1,
+                     const PhaseInstrumentation &instrumentation = {});
+
+struct OpenLoopResult {
+    std::vector<double> latencies_ms;  // intended start to completion
+    std::vector<double> service_ms;    // actual start to completion
+    std::size_t bytes_read = 0;
+    std::size_t failures = 0;
+    double duration_s = 0.0;
+};
+
+// Issues `schedule` open-loop: each request is due at its scheduled time
+// regardless of how earlier requests are doing, with at most `concurrency`
+// requests in flight. Latency is measured from the intended start time, so
+// time spent queued behind slow requests is included.
+OpenLoopResult RunOpenLoop(gcs::Client &client,
+                           const std::string &bucket,
+                           const std::vector<ScheduledRead> &schedule,
+                           int concurrency);
+
+// Reads every (offset, length) range with `concurrency` threads, recording
+// the latency of each range.
+BenchmarkResult RunRangeReads(const std::vector<std::pair<std::size_t, std::size_t>> &ranges,
+                              int concurrency,
+                              const RangeReader &read_range,
+                              std::vector<double> &latencies_ms);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_EXECUTORS_H
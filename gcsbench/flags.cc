@@ -0,0 +1,58 @@
+#include "gcsbench/flags.h"
+
+#include "gcsbench/common.h"
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace gcsbench {
+
+bool ParseFlags(int argc, char *argv[], int first, BenchmarkFlags &flags) {
+    for (int i = first; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            std::cerr << "Error: expected --name=value, got: " << arg << "\n";
+            return false;
+        }
+        flags[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+    }
+    return true;
+}
+
+std::string GetFlag(const BenchmarkFlags &flags, const std::string &name, const std::string &default_value) {
+    auto it = flags.find(name);
+    return it == flags.end() ? default_value : it->second;
+}
+
+std::vector<std::string> SplitList(const std::string &value) {
+    std::vector<std::string> items;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+std::size_t ParseSize(const std::string &value) {
+    std::size_t pos = 0;
+    auto number = std::stoull(value, &pos);
+    auto suffix = value.substr(pos);
+    if (suffix.empty()) return number;
+    if (suffix == "K" || suffix == "KiB") return number * kKiB;
+    if (suffix == "M" || suffix == "MiB") return number * kMiB;
+    throw std::invalid_argument("unknown size suffix: " + value);
+}
+
+std::vector<std::size_t> GetSizeListFlag(const BenchmarkFlags &flags, const std::string &name,
+                                         const std::string &default_value) {
+    std::vector<std::size_t> sizes;
+    for (const auto &item : SplitList(GetFlag(flags, name, default_value))) {
+        sizes.push_back(ParseSize(item));
+    }
+    return sizes;
+}
+
+}  // namespace gcsbench
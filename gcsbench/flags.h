@@ -0,0 +1,28 @@
+#ifndef GCSBENCH_FLAGS_H
+#define GCSBENCH_FLAGS_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace gcsbench {
+
+// Optional flags follow the positional arguments as --name=value.
+using BenchmarkFlags = std::map<std::string, std::string>;
+
+bool ParseFlags(int argc, char *argv[], int first, BenchmarkFlags &flags);
+
+std::string GetFlag(const BenchmarkFlags &flags, const std::string &name, const std::string &default_value);
+
+std::vector<std::string> SplitList(const std::string &value);
+
+// Accepts plain byte counts or a KiB/MiB (also K/M) suffix, e.g. "100KiB".
+std::size_t ParseSize(const std::string &value);
+
+std::vector<std::size_t> GetSizeListFlag(const BenchmarkFlags &flags, const std::string &name,
+                                         const std::string &default_value);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_FLAGS_H
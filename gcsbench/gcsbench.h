@@ -0,0 +1,27 @@
+#ifndef GCSBENCH_GCSBENCH_H
+#define GCSBENCH_GCSBENCH_H
+
+// Convenience header for embedding the benchmark library: pulls in every
+// public module.
+#include "gcsbench/autotune.h"
+#include "gcsbench/backends.h"
+#include "gcsbench/clients.h"
+#include "gcsbench/common.h"
+#include "gcsbench/crc32c.h"
+#include "gcsbench/executors.h"
+#include "gcsbench/flags.h"
+#include "gcsbench/http_backends.h"
+#include "gcsbench/memory.h"
+#include "gcsbench/profiler.h"
+#include "gcsbench/reporters.h"
+#include "gcsbench/scenarios.h"
+#include "gcsbench/stats.h"
+#include "gcsbench/streaming.h"
+#include "gcsbench/timeline.h"
+#include "gcsbench/tls.h"
+#include "gcsbench/tracing.h"
+#include "gcsbench/transport.h"
+#include "gcsbench/uring_backend.h"
+#include "gcsbench/workloads.h"
+
+#endif  // GCSBENCH_GCSBENCH_H
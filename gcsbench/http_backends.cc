@@ -0,0 +1,641 @@
+#include "gcsbench/http_backends.h"
+
+#include "gcsbench/transport.h"
+
+#include "google/cloud/storage/oauth2/google_credentials.h"
+
+#include <curl/curl.h>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gcsbench {
+
+namespace {
+
+// Adds authentication headers for a request on `path` (already URL-encoded).
+using RequestSigner =
+    std::function<bool(const std::string &method, const std::string &path, std::vector<std::string> &headers)>;
+
+std::string Hex(const unsigned char *data, std::size_t size) {
+    static const char kHex[] = "0123456789abcdef";
+    std::string out;
+    out.reserve(2 * size);
+    for (std::size_t i = 0; i < size; ++i) {
+        out += kHex[data[i] >> 4];
+        out += kHex[data[i] & 0xF];
+    }
+    return out;
+}
+
+std::string Sha256Hex(const std::string &data) {
+    unsigned char digest[SHA256_DIGEST_LENGTH];
+    SHA256(reinterpret_cast<const unsigned char *>(data.data()), data.size(), digest);
+    return Hex(digest, sizeof(digest));
+}
+
+std::string HmacSha256(const std::string &key, const std::string &data) {
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int length = 0;
+    HMAC(EVP_sha256(), key.data(), static_cast<int>(key.size()), reinterpret_cast<const unsigned char *>(data.data()),
+         data.size(), digest, &length);
+    return std::string(reinterpret_cast<const char *>(digest), length);
+}
+
+// Splits "scheme://host[:port][/prefix]" into the base URL (without a
+// trailing slash) and the host header value.
+bool ParseEndpoint(std::string endpoint, std::string &base_url, std::string &host) {
+    while (!endpoint.empty() && endpoint.back() == '/') endpoint.pop_back();
+    auto scheme_end = endpoint.find("://");
+    if (scheme_end == std::string::npos) {
+        std::cerr << "Error: endpoint must start with http:// or https://: " << endpoint << "\n";
+        return false;
+    }
+    auto host_start = scheme_end + 3;
+    auto host_end = endpoint.find('/', host_start);
+    host = endpoint.substr(host_start, host_end == std::string::npos ? std::string::npos : host_end - host_start);
+    base_url = endpoint;
+    return !host.empty();
+}
+
+// AWS Signature Version 4 for S3 requests without a body. Signs the host,
+// x-amz-content-sha256 and x-amz-date headers (plus the session token, when
+// there is one) and adds them to `headers` along with Authorization.
+RequestSigner MakeSigV4Signer(std::string host,
+                              std::string region,
+                              std::string access_key,
+                              std::string secret_key,
+                              std::string session_token) {
+    return [=](const std::string &method, const std::string &path, std::vector<std::string> &headers) {
+        static const std::string kEmptyPayloadHash =
+            "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+        std::time_t now = std::time(nullptr);
+        std::tm utc{};
+        gmtime_r(&now, &utc);
+        char amz_date[17];
+        std::strftime(amz_date, sizeof(amz_date), "%Y%m%dT%H%M%SZ", &utc);
+        std::string date(amz_date, 8);
+        std::string scope = date + "/" + region + "/s3/aws4_request";
+
+        std::string canonical_headers = "host:" + host + "\nx-amz-content-sha256:" + kEmptyPayloadHash +
+                                        "\nx-amz-date:" + amz_date + "\n";
+        std::string signed_headers = "host;x-amz-content-sha256;x-amz-date";
+        if (!session_token.empty()) {
+            canonical_headers += "x-amz-security-token:" + session_token + "\n";
+            signed_headers += ";x-amz-security-token";
+        }
+        std::string canonical_request =
+            method + "\n" + path + "\n\n" + canonical_headers + "\n" + signed_headers + "\n" + kEmptyPayloadHash;
+        std::string string_to_sign =
+            std::string("AWS4-HMAC-SHA256\n") + amz_date + "\n" + scope + "\n" + Sha256Hex(canonical_request);
+
+        auto key = HmacSha256("AWS4" + secret_key, date);
+        key = HmacSha256(key, region);
+        key = HmacSha256(key, "s3");
+        key = HmacSha256(key, "aws4_request");
+        auto signature = HmacSha256(key, string_to_sign);
+
+        headers.push_back("x-amz-content-sha256: " + kEmptyPayloadHash);
+        headers.push_back(std::string("x-amz-date: ") + amz_date);
+        if (!session_token.empty()) headers.push_back("x-amz-security-token: " + session_token);
+        headers.push_back("Authorization: AWS4-HMAC-SHA256 Credential=" + access_key + "/" + scope +
+                          ", SignedHeaders=" + signed_headers + ", Signature=" +
+                          Hex(reinterpret_cast<const unsigned char *>(signature.data()), signature.size()));
+        return true;
+    };
+}
+
+// Where the bytes of a response go: straight into the caller's buffer for
+// ranged reads, through a reusable buffer for whole-object downloads, or
+// nowhere (counted in place in curl's receive buffer) without a buffer.
+struct ResponseSink {
+    CURL *handle = nullptr;
+    char *buffer = nullptr;
+    std::size_t capacity = 0;
+    std::size_t used = 0;
+    bool wrap = false;  // refill `buffer` from the start once it is full
+    std::size_t total = 0;
+    bool overflow = false;
+    std::string error_body;
+};
+
+std::size_t OnResponseData(char *data, std::size_t size, std::size_t count, void *user_data) {
+    auto &sink = *static_cast<ResponseSink *>(user_data);
+    auto bytes = size * count;
+    long status = 0;
+    curl_easy_getinfo(sink.handle, CURLINFO_RESPONSE_CODE, &status);
+    if (status >= 300) {
+        sink.error_body.append(data, std::min<std::size_t>(bytes, 1024));
+        return bytes;
+    }
+    for (std::size_t done = 0; sink.buffer != nullptr && done < bytes;) {
+        if (sink.used == sink.capacity) {
+            if (!sink.wrap) {
+                sink.overflow = true;
+                return 0;
+            }
+            sink.used = 0;
+        }
+        auto n = std::min(bytes - done, sink.capacity - sink.used);
+        std::memcpy(sink.buffer + sink.used, data + done, n);
+        sink.used += n;
+        done += n;
+    }
+    sink.total += bytes;
+    g_progress.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    return bytes;
+}
+
+// Easy handles kept between requests. curl_easy_reset() leaves a handle's
+// connection cache alone, so a reused handle keeps its warm connection.
+class EasyHandlePool {
+public:
+    EasyHandlePool() = default;
+    ~EasyHandlePool() {
+        for (auto *handle : idle_) curl_easy_cleanup(handle);
+    }
+
+    EasyHandlePool(const EasyHandlePool &) = delete;
+    EasyHandlePool &operator=(const EasyHandlePool &) = delete;
+
+    CURL *Acquire() {
+        CURL *handle = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (!idle_.empty()) {
+                handle = idle_.back();
+                idle_.pop_back();
+            }
+        }
+        if (handle == nullptr) return curl_easy_init();
+        curl_easy_reset(handle);
+        return handle;
+    }
+
+    void Release(CURL *handle) {
+        std::lock_guard<std::mutex> lock(mu_);
+        idle_.push_back(handle);
+    }
+
+private:
+    std::mutex mu_;
+    std::vector<CURL *> idle_;
+};
+
+// Configures `handle` for one request. The returned header list must outlive
+// the transfer.
+curl_slist *PrepareTransfer(CURL *handle,
+                            const std::string &method,
+                            const std::string &url,
+                            const std::vector<std::string> &header_lines,
+                            long http_version,
+                            ResponseSink &sink) {
+    curl_slist *headers = nullptr;
+    for (const auto &line : header_lines) headers = curl_slist_append(headers, line.c_str());
+    sink.handle = handle;
+    curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, http_version);
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle, CURLOPT_BUFFERSIZE, 512L * 1024L);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, OnResponseData);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &sink);
+    if (method == "HEAD") curl_easy_setopt(handle, CURLOPT_NOBODY, 1L);
+    return headers;
+}
+
+// Returns false (after logging) unless the transfer completed with a 2xx
+// status and fit the sink.
+bool CheckTransfer(const std::string &name,
+                   const std::string &method,
+                   const std::string &url,
+                   CURLcode code,
+                   long status,
+                   const ResponseSink &sink) {
+    if (sink.overflow) {
+        std::cerr << "Error: " << name << " returned more than the " << sink.capacity << " bytes requested\n";
+        return false;
+    }
+    if (code != CURLE_OK) {
+        std::cerr << "Error: " << name << " " << method << " " << url << ": " << curl_easy_strerror(code) << "\n";
+        return false;
+    }
+    if (status >= 300) {
+        std::cerr << "Error: " << name << " " << method << " " << url << ": HTTP " << status << " "
+                  << sink.error_body << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Objects at "<base_url>/<bucket>/<object>": S3 and the GCS XML API.
+class CurlBackend : public StorageBackend {
+public:
+    CurlBackend(std::string name,
+                std::string base_url,
+                std::string host,
+                long http_version,
+                std::string bucket_override,
+                RequestSigner signer)
+        : name_(std::move(name)),
+          base_url_(std::move(base_url)),
+          host_(std::move(host)),
+          http_version_(http_version),
+          bucket_override_(std::move(bucket_override)),
+          signer_(std::move(signer)) {}
+
+    std::string Name() const override { return name_; }
+
+    bool ObjectSize(const std::string &bucket, const std::string &object_name, std::size_t &size) override {
+        ResponseSink sink;
+        curl_off_t length = -1;
+        if (!Perform("HEAD", bucket, object_name, "", sink, &length)) return false;
+        if (length < 0) {
+            std::cerr << "Error: " << name_ << " HEAD response for " << object_name << " has no Content-Length\n";
+            return false;
+        }
+        size = static_cast<std::size_t>(length);
+        return true;
+    }
+
+    bool ReadObject(const std::string &bucket,
+                    const std::string &object_name,
+                    std::size_t buffer_size,
+                    std::size_t &bytes_read) override {
+        std::vector<char> buffer(buffer_size);
+        ResponseSink sink;
+        sink.buffer = buffer.data();
+        sink.capacity = buffer.size();
+        sink.wrap = true;
+        bool ok = Perform("GET", bucket, object_name, "", sink, nullptr);
+        bytes_read = sink.total;
+        return ok;
+    }
+
+    bool ReadRange(const std::string &bucket,
+                   const std::string &object_name,
+                   std::size_t offset,
+                   std::size_t length,
+                   char *buffer,
+                   std::size_t &bytes_read) override {
+        ResponseSink sink;
+        sink.buffer = buffer;
+        sink.capacity = length;
+        bool ok = Perform("GET", bucket, object_name,
+                          "Range: bytes=" + std::to_string(offset) + "-" + std::to_string(offset + length - 1), sink,
+                          nullptr);
+        bytes_read = sink.total;
+        return ok;
+    }
+
+private:
+    bool Perform(const std::string &method,
+                 const std::string &bucket,
+                 const std::string &object_name,
+                 const std::string &range_header,
+                 ResponseSink &sink,
+                 curl_off_t *content_length) {
+        auto path = "/" + UriEncode(bucket_override_.empty() ? bucket : bucket_override_, false) + "/" +
+                    UriEncode(object_name, true);
+        std::vector<std::string> header_lines = {"Host: " + host_};
+        if (!range_header.empty()) header_lines.push_back(range_header);
+        if (!signer_(method, path, header_lines)) return false;
+
+        auto *handle = handles_.Acquire();
+        if (handle == nullptr) {
+            std::cerr << "Error: curl_easy_init failed\n";
+            return false;
+        }
+        auto url = base_url_ + path;
+        auto *headers = PrepareTransfer(handle, method, url, header_lines, http_version_, sink);
+
+        g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+        auto code = curl_easy_perform(handle);
+        long status = 0;
+        curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &status);
+        if (content_length != nullptr) {
+            curl_easy_getinfo(handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, content_length);
+        }
+        curl_slist_free_all(headers);
+        handles_.Release(handle);
+        return CheckTransfer(name_, method, url, code, status, sink);
+    }
+
+    std::string name_;
+    std::string base_url_;
+    std::string host_;
+    long http_version_;
+    std::string bucket_override_;
+    RequestSigner signer_;
+    EasyHandlePool handles_;
+};
+
+// The JSON API media download the JSON client issues, on a single libcurl
+// multi handle driven by its own thread. Readers on any thread queue their
+// transfer and wait for it, so every request shares the multi handle's
+// connection cache and, over HTTP/2, multiplexes on the same connections.
+// Ranges are written straight into the caller's buffer and whole objects are
+// consumed in curl's receive buffer, so no bytes are copied that the caller
+// did not ask for.
+class CurlMultiBackend : public StorageBackend {
+public:
+    CurlMultiBackend(std::string base_url, long http_version, std::string ca_file, RequestSigner signer)
+        : base_url_(std::move(base_url)),
+          http_version_(http_version),
+          ca_file_(std::move(ca_file)),
+          signer_(std::move(signer)) {
+        multi_ = curl_multi_init();
+        curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        loop_ = std::thread([this] { Loop(); });
+    }
+
+    ~CurlMultiBackend() override {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            stop_ = true;
+        }
+        curl_multi_wakeup(multi_);
+        loop_.join();
+        curl_multi_cleanup(multi_);
+    }
+
+    CurlMultiBackend(const CurlMultiBackend &) = delete;
+    CurlMultiBackend &operator=(const CurlMultiBackend &) = delete;
+
+    std::string Name() const override { return "raw-curl"; }
+
+    bool ObjectSize(const std::string &bucket, const std::string &object_name, std::size_t &size) override {
+        std::vector<char> body(4 * kKiB);
+        ResponseSink sink;
+        sink.buffer = body.data();
+        sink.capacity = body.size();
+        if (!Perform(ObjectPath(bucket, object_name) + "?fields=size", "", sink)) return false;
+        std::string json(body.data(), sink.used);
+        if (!ParseObjectSize(json, size)) {
+            std::cerr << "Error: no size in object metadata for " << bucket << "/" << object_name << ": " << json
+                      << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool ReadObject(const std::string &bucket,
+                    const std::string &object_name,
+                    std::size_t,
+                    std::size_t &bytes_read) override {
+        ResponseSink sink;
+        bool ok = Perform(ObjectPath(bucket, object_name) + "?alt=media", "", sink);
+        bytes_read = sink.total;
+        return ok;
+    }
+
+    bool ReadRange(const std::string &bucket,
+                   const std::string &object_name,
+                   std::size_t offset,
+                   std::size_t length,
+                   char *buffer,
+                   std::size_t &bytes_read) override {
+        ResponseSink sink;
+        sink.buffer = buffer;
+        sink.capacity = length;
+        bool ok = Perform(ObjectPath(bucket, object_name) + "?alt=media",
+                          "Range: bytes=" + std::to_string(offset) + "-" + std::to_string(offset + length - 1), sink);
+        bytes_read = sink.total;
+        return ok;
+    }
+
+private:
+    struct Transfer {
+        CURL *handle = nullptr;
+        ResponseSink *sink = nullptr;
+        CURLcode code = CURLE_OK;
+        bool done = false;
+    };
+
+    static std::string ObjectPath(const std::string &bucket, const std::string &object_name) {
+        return "/storage/v1/b/" + UriEncode(bucket, false) + "/o/" + UriEncode(object_name, false);
+    }
+
+    bool Perform(const std::string &path, const std::string &range_header, ResponseSink &sink) {
+        std::vector<std::string> header_lines;
+        if (!range_header.empty()) header_lines.push_back(range_header);
+        if (!signer_("GET", path, header_lines)) return false;
+
+        Transfer transfer;
+        transfer.handle = handles_.Acquire();
+        if (transfer.handle == nullptr) {
+            std::cerr << "Error: curl_easy_init failed\n";
+            return false;
+        }
+        transfer.sink = &sink;
+        auto url = base_url_ + path;
+        auto *headers = PrepareTransfer(transfer.handle, "GET", url, header_lines, http_version_, sink);
+        curl_easy_setopt(transfer.handle, CURLOPT_PRIVATE, &transfer);
+        if (!ca_file_.empty()) curl_easy_setopt(transfer.handle, CURLOPT_CAINFO, ca_file_.c_str());
+        // Wait for a connection that can multiplex rather than opening a new one.
+        curl_easy_setopt(transfer.handle, CURLOPT_PIPEWAIT, 1L);
+
+        g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::unique_lock<std::mutex> lock(mu_);
+            pending_.push_back(&transfer);
+            curl_multi_wakeup(multi_);
+            done_cv_.wait(lock, [&] { return transfer.done; });
+        }
+        long status = 0;
+        curl_easy_getinfo(transfer.handle, CURLINFO_RESPONSE_CODE, &status);
+        curl_slist_free_all(headers);
+        handles_.Release(transfer.handle);
+        return CheckTransfer("raw-curl", "GET", url, transfer.code, status, sink);
+    }
+
+    void Loop() {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                if (stop_) break;
+                for (auto *transfer : pending_) curl_multi_add_handle(multi_, transfer->handle);
+                pending_.clear();
+            }
+            int running = 0;
+            curl_multi_perform(multi_, &running);
+            int queued = 0;
+            while (auto *message = curl_multi_info_read(multi_, &queued)) {
+                if (message->msg != CURLMSG_DONE) continue;
+                char *private_data = nullptr;
+                curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &private_data);
+                auto *transfer = reinterpret_cast<Transfer *>(private_data);
+                auto code = message->data.result;
+                curl_multi_remove_handle(multi_, message->easy_handle);
+                std::lock_guard<std::mutex> lock(mu_);
+                transfer->code = code;
+                transfer->done = true;
+                done_cv_.notify_all();
+            }
+            curl_multi_poll(multi_, nullptr, 0, 1000, nullptr);
+        }
+    }
+
+    std::string base_url_;
+    long http_version_;
+    std::string ca_file_;
+    RequestSigner signer_;
+    EasyHandlePool handles_;
+    CURLM *multi_ = nullptr;
+    std::mutex mu_;
+    std::condition_variable done_cv_;
+    std::vector<Transfer *> pending_;
+    bool stop_ = false;
+    std::thread loop_;
+};
+
+void InitializeCurl() {
+    static bool initialized = curl_global_init(CURL_GLOBAL_DEFAULT) == CURLE_OK;
+    (void)initialized;
+}
+
+// Authorization: Bearer from --access-token or GOOGLE_OAUTH_ACCESS_TOKEN,
+// otherwise from the application default credentials, which the library
+// refreshes as tokens expire.
+bool MakeBearerTokenSigner(const BenchmarkFlags &flags, const std::string &backend, RequestSigner &signer) {
+    auto token = GetFlag(flags, "access-token", "");
+    if (token.empty() && std::getenv("GOOGLE_OAUTH_ACCESS_TOKEN") != nullptr) {
+        token = std::getenv("GOOGLE_OAUTH_ACCESS_TOKEN");
+    }
+    if (!token.empty()) {
+        signer = [token](const std::string &, const std::string &, std::vector<std::string> &headers) {
+            headers.push_back("Authorization: Bearer " + token);
+            return true;
+        };
+        return true;
+    }
+
+    auto credentials = gcs::oauth2::GoogleDefaultCredentials();
+    if (!credentials) {
+        std::cerr << "Error: no credentials for the " << backend << " backend: " << credentials.status() << "\n";
+        return false;
+    }
+    signer = [credentials = *credentials](const std::string &, const std::string &,
+                                          std::vector<std::string> &headers) {
+        auto header = credentials->AuthorizationHeader();
+        if (!header) {
+            std::cerr << "Error: cannot refresh the access token: " << header.status() << "\n";
+            return false;
+        }
+        headers.push_back(*header);
+        return true;
+    };
+    return true;
+}
+
+// Plain-text endpoints (local fakes and emulators) need prior knowledge for
+// HTTP/2; TLS endpoints negotiate it with ALPN.
+long Http2Version(const std::string &base_url) {
+    return base_url.compare(0, 8, "https://") == 0 ? CURL_HTTP_VERSION_2TLS : CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE;
+}
+
+}  // namespace
+
+std::string UriEncode(const std::string &value, bool keep_slash) {
+    static const char kHex[] = "0123456789ABCDEF";
+    std::string out;
+    for (unsigned char c : value) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' || (keep_slash && c == '/')) {
+            out += static_cast<char>(c);
+        } else {
+            out += '%';
+            out += kHex[c >> 4];
+            out += kHex[c & 0xF];
+        }
+    }
+    return out;
+}
+
+bool ParseObjectSize(const std::string &json, std::size_t &size) {
+    // The JSON API encodes 64-bit integers as strings: "size": "<decimal>".
+    auto key = json.find("\"size\"");
+    auto digits = key == std::string::npos ? key : json.find_first_of("0123456789", key + 6);
+    if (digits == std::string::npos) return false;
+    size = std::stoull(json.substr(digits));
+    return true;
+}
+
+std::unique_ptr<StorageBackend> MakeS3Backend(const BenchmarkFlags &flags) {
+    std::string base_url;
+    std::string host;
+    if (!ParseEndpoint(GetFlag(flags, "s3-endpoint", ""), base_url, host)) {
+        std::cerr << "Error: the s3 backend needs --s3-endpoint=http(s)://host:port\n";
+        return nullptr;
+    }
+    auto *access_key = std::getenv("AWS_ACCESS_KEY_ID");
+    auto *secret_key = std::getenv("AWS_SECRET_ACCESS_KEY");
+    if (access_key == nullptr || secret_key == nullptr) {
+        std::cerr << "Error: the s3 backend needs AWS_ACCESS_KEY_ID and AWS_SECRET_ACCESS_KEY\n";
+        return nullptr;
+    }
+    auto *session_token = std::getenv("AWS_SESSION_TOKEN");
+    InitializeCurl();
+    auto signer = MakeSigV4Signer(host, GetFlag(flags, "s3-region", "us-east-1"), access_key, secret_key,
+                                  session_token == nullptr ? "" : session_token);
+    return std::make_unique<CurlBackend>("s3", base_url, host, CURL_HTTP_VERSION_1_1, GetFlag(flags, "s3-bucket", ""),
+                                         std::move(signer));
+}
+
+std::unique_ptr<StorageBackend> MakeHttp2Backend(const BenchmarkFlags &flags) {
+    std::string base_url;
+    std::string host;
+    if (!ParseEndpoint(GetFlag(flags, "http2-endpoint", "https://storage.googleapis.com"), base_url, host)) {
+        return nullptr;
+    }
+    RequestSigner signer;
+    if (!MakeBearerTokenSigner(flags, "http2", signer)) return nullptr;
+    InitializeCurl();
+    return std::make_unique<CurlBackend>("http2", base_url, host, Http2Version(base_url), "", std::move(signer));
+}
+
+std::string RawCurlEndpoint(const BenchmarkFlags &flags) {
+    return GetFlag(flags, "raw-curl-endpoint", SelectedTransport().JsonEndpoint());
+}
+
+std::unique_ptr<StorageBackend> MakeCurlMultiBackend(const BenchmarkFlags &flags) {
+    const auto &selection = SelectedTransport();
+    auto endpoint = RawCurlEndpoint(flags);
+    std::string base_url;
+    std::string host;
+    if (!ParseEndpoint(endpoint, base_url, host)) {
+        return nullptr;
+    }
+    // Empty keeps libcurl's default, which is also what the JSON client uses.
+    auto version = GetFlag(flags, "raw-curl-http-version", "");
+    long http_version = CURL_HTTP_VERSION_NONE;
+    if (version == "1.1") {
+        http_version = CURL_HTTP_VERSION_1_1;
+    } else if (version == "2") {
+        http_version = Http2Version(base_url);
+    } else if (!version.empty()) {
+        std::cerr << "Error: --raw-curl-http-version must be 1.1 or 2\n";
+        return nullptr;
+    }
+    RequestSigner signer;
+    if (endpoint == selection.JsonEndpoint() && (!selection.tls || selection.json_emulator)) {
+        // The JSON client sends no credentials to a plaintext endpoint or the emulator either.
+        signer = [](const std::string &, const std::string &, std::vector<std::string> &) { return true; };
+    } else if (!MakeBearerTokenSigner(flags, "raw-curl", signer)) {
+        return nullptr;
+    }
+    InitializeCurl();
+    return std::make_unique<CurlMultiBackend>(base_url, http_version, selection.ca_file, std::move(signer));
+}
+
+}  // namespace gcsbench
@@ -0,0 +1,47 @@
+#ifndef GCSBENCH_HTTP_BACKENDS_H
+#define GCSBENCH_HTTP_BACKENDS_H
+
+#include "gcsbench/backends.h"
+#include "gcsbench/flags.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace gcsbench {
+
+// Percent-encodes everything but RFC 3986 unreserved characters; with
+// `keep_slash` the path separators stay as they are.
+std::string UriEncode(const std::string &value, bool keep_slash);
+
+// Extracts "size" from a JSON API object resource (e.g. the response to
+// `?fields=size`). Returns false if it is missing.
+bool ParseObjectSize(const std::string &json, std::size_t &size);
+
+// Backends that issue plain HTTP requests through libcurl instead of going
+// through a client library. Each keeps a pool of easy handles, so requests
+// reuse warm connections the way the client libraries do.
+
+// An S3-compatible endpoint (MinIO and the like), path-style requests signed
+// with AWS Signature Version 4. Needs --s3-endpoint and the AWS_ACCESS_KEY_ID
+// and AWS_SECRET_ACCESS_KEY environment variables.
+std::unique_ptr<StorageBackend> MakeS3Backend(const BenchmarkFlags &flags);
+
+// The GCS XML API over HTTP/2 with an OAuth2 bearer token: the same objects
+// the client libraries read, with no library code between the workload and
+// libcurl.
+std::unique_ptr<StorageBackend> MakeHttp2Backend(const BenchmarkFlags &flags);
+
+// The raw-curl backend's endpoint: --raw-curl-endpoint, or else the JSON
+// client's selected endpoint (emulator included).
+std::string RawCurlEndpoint(const BenchmarkFlags &flags);
+
+// The JSON API media download the JSON client issues, sent by a single
+// libcurl multi handle without the client library's layers, with the JSON
+// client's CA file and credentials. Options: --raw-curl-endpoint and
+// --raw-curl-http-version (1.1 or 2).
+std::unique_ptr<StorageBackend> MakeCurlMultiBackend(const BenchmarkFlags &flags);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_HTTP_BACKENDS_H
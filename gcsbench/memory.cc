@@ -0,0 +1,120 @@
+#include "gcsbench/memory.h"
+
+#include <malloc.h>
+#include <unistd.h>
+
+#include <fstream>
+
+// Allocator entry points resolved at run time, so the same code reports stats
+// for whichever allocator the binary ended up linked against.
+extern "C" {
+int mallctl(const char *name, void *oldp, std::size_t *oldlenp, void *newp, std::size_t newlen) __attribute__((weak));
+int MallocExtension_GetNumericProperty(const char *property, std::size_t *value) __attribute__((weak));
+void mi_process_info(std::size_t *elapsed_msecs, std::size_t *user_msecs, std::size_t *system_msecs,
+                     std::size_t *current_rss, std::size_t *peak_rss, std::size_t *current_commit,
+                     std::size_t *peak_commit, std::size_t *page_faults) __attribute__((weak));
+}
+
+namespace gcsbench {
+
+namespace {
+
+std::size_t PageSize() {
+    static const std::size_t page_size = sysconf(_SC_PAGESIZE);
+    return page_size;
+}
+
+}  // namespace
+
+std::size_t CurrentRssBytes() {
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * PageSize();
+}
+
+std::size_t PeakRssBytes() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stoull(line.substr(6)) * kKiB;
+        }
+    }
+    return 0;
+}
+
+bool ResetPeakRss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+    return static_cast<bool>(clear_refs);
+}
+
+AllocatorStats GetAllocatorStats() {
+    AllocatorStats stats;
+    if (mallctl) {
+        uint64_t epoch = 1;
+        std::size_t epoch_size = sizeof(epoch);
+        mallctl("epoch", &epoch, &epoch_size, &epoch, epoch_size);
+        std::size_t size = sizeof(std::size_t);
+        stats.allocator = "jemalloc";
+        mallctl("stats.allocated", &stats.in_use_bytes, &size, nullptr, 0);
+        mallctl("stats.resident", &stats.held_bytes, &size, nullptr, 0);
+        return stats;
+    }
+    if (MallocExtension_GetNumericProperty) {
+        stats.allocator = "tcmalloc";
+        MallocExtension_GetNumericProperty("generic.current_allocated_bytes", &stats.in_use_bytes);
+        MallocExtension_GetNumericProperty("generic.heap_size", &stats.held_bytes);
+        return stats;
+    }
+    if (mi_process_info) {
+        std::size_t elapsed, user, system, rss, peak_rss, peak_commit, page_faults;
+        stats.allocator = "mimalloc";
+        mi_process_info(&elapsed, &user, &system, &rss, &peak_rss, &stats.held_bytes, &peak_commit, &page_faults);
+        stats.in_use_bytes = stats.held_bytes;  // mimalloc only reports committed memory
+        return stats;
+    }
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    auto info = mallinfo2();
+    stats.allocator = "glibc";
+    stats.in_use_bytes = info.uordblks + info.hblkhd;
+    stats.held_bytes = info.arena + info.hblkhd;
+#else
+    stats.allocator = "unknown";
+#endif
+    return stats;
+}
+
+void MemorySampler::Start() {
+    ResetPeakRss();
+    summary_ = Summary{};
+    summary_.start_rss = CurrentRssBytes();
+    start_allocations_ = g_allocations.allocations.load();
+    start_allocated_bytes_ = g_allocations.bytes.load();
+    stop_ = false;
+    thread_ = std::thread([this] {
+        double total = 0.0;
+        std::size_t samples = 0;
+        while (!stop_) {
+            total += CurrentRssBytes();
+            ++samples;
+            std::this_thread::sleep_for(interval_);
+        }
+        summary_.mean_rss = samples ? static_cast<std::size_t>(total / samples) : 0;
+    });
+}
+
+MemorySampler::Summary MemorySampler::Stop() {
+    if (thread_.joinable()) {
+        stop_ = true;
+        thread_.join();
+        summary_.peak_rss = PeakRssBytes();
+        summary_.allocator = GetAllocatorStats();
+        summary_.allocations = g_allocations.allocations.load() - start_allocations_;
+        summary_.allocated_bytes = g_allocations.bytes.load() - start_allocated_bytes_;
+    }
+    return summary_;
+}
+
+}  // namespace gcsbench
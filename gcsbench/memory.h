@@ -0,0 +1,62 @@
+#ifndef GCSBENCH_MEMORY_H
+#define GCSBENCH_MEMORY_H
+
+#include "gcsbench/common.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace gcsbench {
+
+std::size_t CurrentRssBytes();
+
+// VmHWM, the peak resident set size since start or the last ResetPeakRss().
+std::size_t PeakRssBytes();
+
+bool ResetPeakRss();
+
+struct AllocatorStats {
+    std::string allocator;
+    std::size_t in_use_bytes = 0;  // allocated by the application
+    std::size_t held_bytes = 0;    // obtained from the OS, including free lists
+};
+
+AllocatorStats GetAllocatorStats();
+
+// Samples the resident set size on a background thread between Start() and
+// Stop(); Start() also resets the kernel's peak RSS and snapshots the
+// allocation counters so each phase reports only its own activity.
+class MemorySampler {
+public:
+    struct Summary {
+        std::size_t start_rss = 0;
+        std::size_t mean_rss = 0;
+        std::size_t peak_rss = 0;
+        AllocatorStats allocator;
+        uint64_t allocations = 0;
+        uint64_t allocated_bytes = 0;
+    };
+
+    explicit MemorySampler(std::chrono::milliseconds interval = std::chrono::milliseconds(50)) : interval_(interval) {}
+    ~MemorySampler() { Stop(); }
+
+    void Start();
+
+    Summary Stop();
+
+private:
+    std::chrono::milliseconds interval_;
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+    Summary summary_;
+    uint64_t start_allocations_ = 0;
+    uint64_t start_allocated_bytes_ = 0;
+};
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_MEMORY_H
@@ -0,0 +1,214 @@
+#include "gcsbench/profiler.h"
+
+#include "gcsbench/common.h"
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#ifdef GCS_BENCHMARK_HAVE_GPERFTOOLS
+#include <gperftools/profiler.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace gcsbench {
+
+namespace {
+
+constexpr int kMaxDepth = 64;
+constexpr std::size_t kMaxSamples = 200000;
+
+struct Sample {
+    int depth;
+    void *pc;
+    void *frames[kMaxDepth];
+};
+
+// Allocated on the first Start() and kept for the life of the process. It is
+// not zero-filled, so only the pages samples are written to become resident.
+std::unique_ptr<Sample[]> g_samples;
+std::atomic<std::size_t> g_next_sample{0};
+std::size_t g_resident_samples = 0;
+std::atomic<bool> g_active{false};
+bool g_handler_installed = false;
+
+void OnSignal(void *context) {
+    // The handler stays installed after Stop(): a process-directed SIGPROF
+    // still pending then must not fall back to the default action (exit).
+    if (!g_active.load(std::memory_order_relaxed)) return;
+    auto index = g_next_sample.fetch_add(1, std::memory_order_relaxed);
+    if (index >= kMaxSamples) return;
+    auto &sample = g_samples[index];
+    sample.pc = nullptr;
+#if defined(__x86_64__)
+    sample.pc = reinterpret_cast<void *>(static_cast<ucontext_t *>(context)->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+    sample.pc = reinterpret_cast<void *>(static_cast<ucontext_t *>(context)->uc_mcontext.pc);
+#endif
+    sample.depth = backtrace(sample.frames, kMaxDepth);
+}
+
+// Function name when the symbol is visible (the benchmark is linked with
+// exported symbols), otherwise module+offset for offline symbolization.
+std::string Symbolize(void *address) {
+    Dl_info info{};
+    if (dladdr(address, &info) == 0) return "[unknown]";
+    if (info.dli_sname != nullptr) {
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string name = status == 0 && demangled ? demangled : info.dli_sname;
+        std::free(demangled);
+        // ';' separates frames in the folded format.
+        std::replace(name.begin(), name.end(), ';', ':');
+        return name;
+    }
+    std::ostringstream os;
+    std::string module = info.dli_fname ? info.dli_fname : "?";
+    os << module.substr(module.find_last_of('/') + 1) << "+0x" << std::hex
+       << (static_cast<char *>(address) - static_cast<char *>(info.dli_fbase));
+    return os.str();
+}
+
+}  // namespace
+
+bool SamplingProfiler::Start(int hz) {
+    if (g_active) return false;
+    // backtrace() allocates on first use; do that outside the handler.
+    void *warmup[1];
+    backtrace(warmup, 1);
+    if (hz <= 0) return false;
+    if (!g_samples) g_samples.reset(new Sample[kMaxSamples]);
+    g_next_sample = 0;
+
+    if (!g_handler_installed) {
+        struct sigaction action {};
+        action.sa_sigaction = [](int, siginfo_t *, void *context) { OnSignal(context); };
+        action.sa_flags = SA_RESTART | SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, nullptr) != 0) return false;
+        g_handler_installed = true;
+    }
+
+    auto interval_us = std::max<long>(1000000L / hz, 1);
+    itimerval timer{};
+    timer.it_interval.tv_sec = interval_us / 1000000;
+    timer.it_interval.tv_usec = interval_us % 1000000;
+    timer.it_value = timer.it_interval;
+    g_active = true;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) g_active = false;
+    return g_active;
+}
+
+void SamplingProfiler::Stop(const std::string &path) {
+    if (!g_active) return;
+    itimerval timer{};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    g_active = false;
+
+    auto count = std::min<std::size_t>(g_next_sample, kMaxSamples);
+    g_resident_samples = std::max(g_resident_samples, count);
+    std::map<std::string, std::size_t> folded;
+    std::map<void *, std::string> symbols;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto &sample = g_samples[i];
+        std::vector<const std::string *> names;
+        for (int f = 0; f < sample.depth; ++f) {
+            auto it = symbols.find(sample.frames[f]);
+            if (it == symbols.end()) it = symbols.emplace(sample.frames[f], Symbolize(sample.frames[f])).first;
+            names.push_back(&it->second);
+        }
+        // Drop the handler's own frames and the signal trampoline: the
+        // interrupted leaf is the frame matching the signal context's PC.
+        std::size_t leaf = std::min<std::size_t>(2, names.size());
+        for (int f = 0; f < sample.depth; ++f) {
+            if (sample.frames[f] == sample.pc) {
+                leaf = f;
+                break;
+            }
+        }
+        std::string stack;
+        for (std::size_t f = names.size(); f > leaf; --f) {
+            if (!stack.empty()) stack += ';';
+            stack += *names[f - 1];
+        }
+        if (!stack.empty()) ++folded[stack];
+    }
+
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Error: cannot write profile " << path << "\n";
+        return;
+    }
+    for (const auto &entry : folded) {
+        out << entry.first << " " << entry.second << "\n";
+    }
+    // The sample buffer's touched pages count towards the phase's RSS.
+    std::cout << "Profile: " << count << " samples written to " << path << " (sample buffer "
+              << g_resident_samples * sizeof(Sample) / static_cast<double>(kMiB) << " MB resident)\n";
+}
+
+ScopedPhaseProfile::ScopedPhaseProfile(const ProfilerOptions &options, const std::string &label)
+    : options_(options), path_(options.dir + "/" + label) {
+    if (options_.profiler == "builtin") {
+        path_ += ".folded";
+        if (!SamplingProfiler::Start(options_.hz)) std::cerr << "Error: could not start the sampling profiler\n";
+    } else if (options_.profiler == "gperftools") {
+        path_ += ".prof";
+#ifdef GCS_BENCHMARK_HAVE_GPERFTOOLS
+        ProfilerStart(path_.c_str());
+#else
+        std::cerr << "Error: built without gperftools (GCS_BENCHMARK_GPERFTOOLS)\n";
+#endif
+    } else if (options_.profiler == "perf") {
+        path_ += ".perf.data";
+        auto pid = std::to_string(getpid());
+        auto frequency = std::to_string(options_.hz);
+        std::vector<std::string> args = {"perf", "record", "-g", "-F", frequency, "-p", pid, "-o", path_};
+        std::vector<char *> argv;
+        for (auto &arg : args) argv.push_back(arg.data());
+        argv.push_back(nullptr);
+        if (posix_spawnp(&perf_pid_, "perf", nullptr, nullptr, argv.data(), environ) != 0) {
+            std::cerr << "Error: could not start perf record\n";
+            perf_pid_ = 0;
+        } else {
+            // Give perf time to attach before the phase starts.
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
+    }
+}
+
+ScopedPhaseProfile::~ScopedPhaseProfile() {
+    if (options_.profiler == "builtin") {
+        SamplingProfiler::Stop(path_);
+    } else if (options_.profiler == "gperftools") {
+#ifdef GCS_BENCHMARK_HAVE_GPERFTOOLS
+        ProfilerStop();
+        std::cout << "Profile: written to " << path_ << "\n";
+#endif
+    } else if (perf_pid_ > 0) {
+        kill(perf_pid_, SIGINT);
+        int status = 0;
+        waitpid(perf_pid_, &status, 0);
+        std::cout << "Profile: written to " << path_ << "\n";
+    }
+}
+
+}  // namespace gcsbench
@@ -0,0 +1,50 @@
+#ifndef GCSBENCH_PROFILER_H
+#define GCSBENCH_PROFILER_H
+
+#include <sys/types.h>
+
+#include <string>
+
+namespace gcsbench {
+
+// SIGPROF-driven sampler: every `hz`-th of a second of process CPU time the
+// kernel interrupts the thread using the CPU and the handler records its call
+// stack into a buffer allocated once per process. Stacks are symbolized after
+// Stop() and written as folded stacks ("root;...;leaf count"), the input
+// format of flamegraph.pl and speedscope.
+class SamplingProfiler {
+public:
+    static bool Start(int hz);
+
+    // Stops sampling and writes the folded stacks to `path`.
+    static void Stop(const std::string &path);
+};
+
+// Which profiler to run around each Run*Benchmark phase.
+struct ProfilerOptions {
+    std::string profiler;  // "builtin", "gperftools", "perf", or empty for none
+    std::string dir;
+    int hz = 999;
+};
+
+// Profiles one benchmark phase, writing `<dir>/<label>` plus an extension
+// that depends on the profiler: ".folded" for the built-in sampler, ".prof"
+// for gperftools (pprof input) and ".perf.data" for perf record, whose
+// samples can be folded with `perf script | stackcollapse-perf.pl`.
+class ScopedPhaseProfile {
+public:
+    ScopedPhaseProfile(const ProfilerOptions &options, const std::string &label);
+    ~ScopedPhaseProfile();
+
+    ScopedPhaseProfile(const ScopedPhaseProfile &) = delete;
+    ScopedPhaseProfile &operator=(const ScopedPhaseProfile &) = delete;
+
+private:
+    ProfilerOptions options_;
+    std::string path_;
+    pid_t perf_pid_ = 0;
+};
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_PROFILER_H
@@ -0,0 +1,124 @@
+#include "gcsbench/reporters.h"
+
+#include "gcsbench/common.h"
+#include "gcsbench/transport.h"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+namespace gcsbench {
+
+namespace {
+
+void PrintEffectivePath(const std::string &type) {
+    auto path = EffectivePathLabel(type);
+    if (!path.empty()) std::cout << "Transport: " << path << "\n";
+}
+
+}  // namespace
+
+void PrintMemorySummary(const MemorySampler::Summary &memory, [[maybe_unused]] std::size_t bytes_read) {
+    std::cout << "RSS start/mean/peak:  " << memory.start_rss / kMiB << " / " << memory.mean_rss / kMiB << " / "
+              << memory.peak_rss / kMiB << " MB\n";
+    std::cout << "Allocator (" << memory.allocator.allocator << "):     " << memory.allocator.in_use_bytes / kMiB
+              << " MB in use, " << memory.allocator.held_bytes / kMiB << " MB held\n";
+#ifdef GCS_BENCHMARK_COUNT_ALLOCATIONS
+    double mb_read = bytes_read / static_cast<double>(kMiB);
+    if (mb_read > 0) {
+        std::cout << "Allocations per MB:   " << memory.allocations / mb_read << " ("
+                  << memory.allocated_bytes / mb_read / kKiB << " KB allocated per MB read)\n";
+    }
+#endif
+}
+
+void PrintSteadyStateSummary(const std::vector<double> &steady_mbs) {
+    if (steady_mbs.empty()) return;
+    std::cout << "Steady-state throughput: "
+              << std::accumulate(steady_mbs.begin(), steady_mbs.end(), 0.0) / steady_mbs.size() << " MB/s\n";
+}
+
+AggregateStats PrintAggregateResults(const std::string &type,
+                                     int num_iterations_attempted,
+                                     size_t file_size_bytes,
+                                     size_t read_size_bytes,
+                                     const std::vector<int64_t> &successful_durations) {
+    auto stats = ComputeAggregateStats(file_size_bytes, successful_durations);
+
+    std::cout << "\n==== " << type << " Read Aggregate Benchmark Results ====\n";
+    PrintEffectivePath(type);
+    double file_size_mb = file_size_bytes / static_cast<double>(kMiB);
+    std::cout << "File size: " << file_size_mb << " MB (" << file_size_bytes << " bytes)\n";
+    if (read_size_bytes > 0) {
+        std::cout << "Read size: " << read_size_bytes / kKiB << " KB" << "\n";
+    }
+    std::cout << "Total successful iterations: " << stats.successful_iterations << " / " << num_iterations_attempted << "\n";
+
+    if (stats.successful_iterations == 0) {
+        std::cout << "No successful iterations. No statistics available.\n";
+        return stats;
+    }
+
+    std::cout << "Average (mean) time: " << stats.avg_duration_ms << " ms"
+              << " (95% CI " << stats.mean_duration_ci_ms.low << " - " << stats.mean_duration_ci_ms.high << ")\n";
+    std::cout << "Std deviation:        " << stats.stddev_duration_ms << " ms\n";
+    std::cout << "P50 (median) time:    " << stats.p50_duration_ms << " ms\n";
+    std::cout << "P90 time:             " << stats.p90_duration_ms << " ms\n";
+    std::cout << "Min time:             " << stats.min_duration_ms << " ms\n";
+    std::cout << "Max time:             " << stats.max_duration_ms << " ms\n";
+    std::cout << "Outliers (1.5 IQR):   " << stats.outliers << ", mean without them "
+              << stats.mean_without_outliers_ms << " ms\n";
+    std::cout << "Average throughput:   " << stats.avg_throughput_mbs << " MB/s"
+              << " (95% CI " << stats.throughput_ci_mbs.low << " - " << stats.throughput_ci_mbs.high << ")\n";
+    return stats;
+}
+
+void PrintLatencyResults(const std::string &type, const OpenLoopResult &result) {
+    auto latencies = result.latencies_ms;
+    auto service = result.service_ms;
+    std::sort(latencies.begin(), latencies.end());
+    std::sort(service.begin(), service.end());
+
+    std::cout << "\n==== " << type << " Latency Under Load ====\n";
+    PrintEffectivePath(type);
+    std::cout << "Requests:             " << latencies.size() + result.failures
+              << " (" << result.failures << " failed)\n";
+    if (latencies.empty()) {
+        std::cout << "No successful requests. No statistics available.\n";
+        return;
+    }
+    double mean = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+    double mb = result.bytes_read / static_cast<double>(kMiB);
+    std::cout << "Achieved rate:        " << (latencies.size() + result.failures) / result.duration_s << " req/s\n";
+    std::cout << "Throughput:           " << mb / result.duration_s << " MB/s\n";
+    std::cout << "Mean latency:         " << mean << " ms\n";
+    std::cout << "P50 latency:          " << Percentile(latencies, 0.5) << " ms\n";
+    std::cout << "P90 latency:          " << Percentile(latencies, 0.9) << " ms\n";
+    std::cout << "P99 latency:          " << Percentile(latencies, 0.99) << " ms\n";
+    std::cout << "P99.9 latency:        " << Percentile(latencies, 0.999) << " ms\n";
+    std::cout << "Max latency:          " << latencies.back() << " ms\n";
+    std::cout << "P50 / P99 service:    " << Percentile(service, 0.5) << " / " << Percentile(service, 0.99) << " ms\n";
+}
+
+void PrintComparison(const std::string &name_a, const std::vector<int64_t> &durations_a,
+                     const std::string &name_b, const std::vector<int64_t> &durations_b) {
+    std::vector<double> a(durations_a.begin(), durations_a.end());
+    std::vector<double> b(durations_b.begin(), durations_b.end());
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    auto test = MannWhitneyU(a, b);
+    double median_a = Percentile(a, 0.5);
+    double median_b = Percentile(b, 0.5);
+
+    std::cout << "\n==== Comparison: " << name_a << " vs " << name_b << " ====\n";
+    std::cout << "Median time:          " << median_a << " ms vs " << median_b << " ms";
+    if (median_b > 0) std::cout << " (ratio " << median_a / median_b << ")";
+    std::cout << "\n";
+    std::cout << "Mann-Whitney U:       " << test.u << " (z = " << test.z << ", p = " << test.p_value << ")\n";
+    std::cout << "Verdict:              "
+              << (test.p_value < 0.05 ? (median_a < median_b ? name_a : name_b) + " is faster (p < 0.05)"
+                                      : std::string("difference is not significant (p >= 0.05)"))
+              << "\n";
+}
+
+}  // namespace gcsbench
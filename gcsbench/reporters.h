@@ -0,0 +1,32 @@
+#ifndef GCSBENCH_REPORTERS_H
+#define GCSBENCH_REPORTERS_H
+
+#include "gcsbench/executors.h"
+#include "gcsbench/memory.h"
+#include "gcsbench/stats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gcsbench {
+
+void PrintMemorySummary(const MemorySampler::Summary &memory, [[maybe_unused]] std::size_t bytes_read);
+
+void PrintSteadyStateSummary(const std::vector<double> &steady_mbs);
+
+AggregateStats PrintAggregateResults(const std::string &type,
+                                     int num_iterations_attempted,
+                                     size_t file_size_bytes,
+                                     size_t read_size_bytes,
+                                     const std::vector<int64_t> &successful_durations);
+
+void PrintLatencyResults(const std::string &type, const OpenLoopResult &result);
+
+void PrintComparison(const std::string &name_a, const std::vector<int64_t> &durations_a,
+                     const std::string &name_b, const std::vector<int64_t> &durations_b);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_REPORTERS_H
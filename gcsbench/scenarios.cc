@@ -0,0 +1,1833 @@
+#include "gcsbench/scenarios.h"
+
+#include "gcsbench/autotune.h"
+#include "gcsbench/backends.h"
+#include "gcsbench/clients.h"
+#include "gcsbench/common.h"
+#include "gcsbench/crc32c.h"
+#include "gcsbench/executors.h"
+#include "gcsbench/http_backends.h"
+#include "gcsbench/memory.h"
+#include "gcsbench/reporters.h"
+#include "gcsbench/stats.h"
+#include "gcsbench/streaming.h"
+#include "gcsbench/tls.h"
+#include "gcsbench/tracing.h"
+#include "gcsbench/transport.h"
+#include "gcsbench/workloads.h"
+
+#include "google/cloud/common_options.h"
+#include "google/cloud/credentials.h"
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/storage/async/client.h"
+#include "google/cloud/storage/client.h"
+#include <grpcpp/security/credentials.h>
+
+#ifdef GCS_BENCHMARK_HAVE_OPENTELEMETRY
+#include "google/cloud/opentelemetry_options.h"
+#include <opentelemetry/sdk/trace/samplers/parent.h>
+#include <opentelemetry/sdk/trace/samplers/trace_id_ratio.h>
+#include <opentelemetry/sdk/trace/simple_processor_factory.h>
+#include <opentelemetry/sdk/trace/tracer_provider.h>
+#include <opentelemetry/trace/noop.h>
+#include <opentelemetry/trace/provider.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gcsbench {
+
+bool ParsePhaseInstrumentation(const BenchmarkFlags &flags, PhaseInstrumentation &instrumentation) {
+    instrumentation.timeline_dir = GetFlag(flags, "timeline-dir", "");
+    instrumentation.timeline_interval =
+        std::chrono::milliseconds(std::stoi(GetFlag(flags, "timeline-interval-ms", "100")));
+    instrumentation.sample_memory = GetFlag(flags, "memory", "false") == "true";
+    instrumentation.profiler.profiler = GetFlag(flags, "profiler", "");
+    instrumentation.profiler.dir = GetFlag(flags, "profile-dir", ".");
+    instrumentation.profiler.hz = std::stoi(GetFlag(flags, "profile-hz", "999"));
+    if (!instrumentation.profiler.profiler.empty() && instrumentation.profiler.profiler != "builtin" &&
+        instrumentation.profiler.profiler != "gperftools" && instrumentation.profiler.profiler != "perf") {
+        std::cerr << "Error: --profiler must be builtin, gperftools or perf\n";
+        return false;
+    }
+    if (instrumentation.profiler.hz <= 0) {
+        std::cerr << "Error: --profile-hz must be positive\n";
+        return false;
+    }
+    if (instrumentation.timeline_interval.count() <= 0) {
+        std::cerr << "Error: --timeline-interval-ms must be positive\n";
+        return false;
+    }
+    return true;
+}
+
+void RunDefaultBenchmark(int num_iterations,
+                         const std::string &bucket,
+                         const std::string &object_name,
+                         int concurrency,
+                         const PhaseInstrumentation &instrumentation) {
+    auto options = gc::Options{};
+    auto jsonClient = MakeJsonClient(options);
+    auto grpcClient = MakeGrpcClient(options);
+
+    RunSequentialBenchmark(num_iterations, grpcClient, bucket, object_name, "GRPC Client", instrumentation);
+    RunSequentialBenchmark(num_iterations, jsonClient, bucket, object_name, "Json Client", instrumentation);
+
+    std::vector<std::size_t> read_sizes = {
+        4 * kMiB,
+        2 * kMiB,
+        1 * kMiB,
+        100 * kKiB
+    };
+
+    for (auto size : read_sizes) {
+        RunRandomBenchmark(num_iterations, grpcClient, bucket, object_name, size, "GRPC Client", concurrency, instrumentation);
+        RunRandomBenchmark(num_iterations, jsonClient, bucket, object_name, size, "JSON Client", concurrency, instrumentation);
+    }
+}
+
+void RunJsonTuningSweep(int num_iterations,
+                        const std::string &bucket,
+                        const std::string &object_name,
+                        const BenchmarkFlags &flags) {
+    auto pool_sizes = GetSizeListFlag(flags, "pool-sizes", "4,32");
+    auto download_buffer_sizes = GetSizeListFlag(flags, "download-buffer-sizes", "256KiB,4MiB");
+    auto http_versions = SplitList(GetFlag(flags, "http-versions", "1.1,2.0"));
+    auto socket_buffer_sizes = GetSizeListFlag(flags, "socket-buffer-sizes", "0,4MiB");
+    auto read_sizes = GetSizeListFlag(flags, "read-sizes", "1MiB,100KiB");
+    int concurrency = std::stoi(GetFlag(flags, "concurrency", "8"));
+
+    struct SweepRow {
+        std::string label;
+        double sequential_mbs;
+        std::vector<double> random_mbs;
+    };
+    std::vector<SweepRow> rows;
+
+    auto run_workloads = [&](gcs::Client &client, const std::string &label) {
+        SweepRow row{label, 0.0, {}};
+        row.sequential_mbs = RunSequentialBenchmark(num_iterations, client, bucket, object_name, label).avg_throughput_mbs;
+        for (auto size : read_sizes) {
+            row.random_mbs.push_back(
+                RunRandomBenchmark(num_iterations, client, bucket, object_name, size, label, concurrency).avg_throughput_mbs);
+        }
+        rows.push_back(std::move(row));
+    };
+
+    auto grpc_client = MakeGrpcClient();
+    run_workloads(grpc_client, "GRPC Client (default)");
+
+    for (auto pool_size : pool_sizes) {
+        for (auto download_buffer_size : download_buffer_sizes) {
+            for (const auto &http_version : http_versions) {
+                for (auto socket_buffer_size : socket_buffer_sizes) {
+                    JsonTransportConfig config{pool_size, download_buffer_size, http_version, socket_buffer_size};
+                    auto client = MakeTunedJsonClient(config);
+                    run_workloads(client, "Json Client " + config.Label());
+                }
+            }
+        }
+    }
+
+    std::cout << "\n==== JSON Transport Sweep Summary (avg MB/s, random concurrency " << concurrency << ") ====\n";
+    std::cout << std::left << std::setw(60) << "Configuration" << std::setw(12) << "Sequential";
+    for (auto size : read_sizes) {
+        std::cout << std::setw(12) << ("Rand " + FormatSize(size));
+    }
+    std::cout << "\n";
+    for (const auto &row : rows) {
+        std::cout << std::setw(60) << row.label << std::setw(12) << row.sequential_mbs;
+        for (auto mbs : row.random_mbs) {
+            std::cout << std::setw(12) << mbs;
+        }
+        std::cout << "\n";
+    }
+    std::cout << std::right;
+}
+
+void RunGrpcFlowControlSweep(int num_iterations,
+                             const std::string &bucket,
+                             const std::string &object_name,
+                             const BenchmarkFlags &flags) {
+    auto window_sizes = GetSizeListFlag(flags, "window-sizes", "0,64KiB,1MiB,8MiB");
+    auto bdp_probes = SplitList(GetFlag(flags, "bdp-probes", "on,off"));
+    auto max_message_sizes = GetSizeListFlag(flags, "max-message-sizes", "0");
+    auto read_sizes = GetSizeListFlag(flags, "read-sizes", "1MiB,100KiB");
+    int concurrency = std::stoi(GetFlag(flags, "concurrency", "8"));
+    for (const auto &probe : bdp_probes) {
+        if (probe != "on" && probe != "off") {
+            std::cerr << "Error: --bdp-probes must list on and/or off\n";
+            return;
+        }
+    }
+
+    // A sequential read is one ReadObject stream; the random reads put
+    // `concurrency` streams on the client's channels at once.
+    struct SweepRow {
+        GrpcTransportConfig config;
+        double sequential_mbs;
+        std::vector<double> random_mbs;
+    };
+    std::vector<SweepRow> rows;
+    for (auto max_message_size : max_message_sizes) {
+        for (auto window_size : window_sizes) {
+            for (const auto &probe : bdp_probes) {
+                GrpcTransportConfig config{window_size, probe, max_message_size};
+                auto client = MakeTunedGrpcClient(config);
+                auto label = "GRPC Client " + config.Label();
+                SweepRow row{config, 0.0, {}};
+                row.sequential_mbs =
+                    RunSequentialBenchmark(num_iterations, client, bucket, object_name, label).avg_throughput_mbs;
+                for (auto size : read_sizes) {
+                    row.random_mbs.push_back(
+                        RunRandomBenchmark(num_iterations, client, bucket, object_name, size, label, concurrency)
+                            .avg_throughput_mbs);
+                }
+                rows.push_back(std::move(row));
+            }
+        }
+    }
+
+    std::cout << "\n==== gRPC Flow-Control Sweep (MB/s per stream, random concurrency " << concurrency << ") ====\n";
+    std::cout << std::left << std::setw(44) << "Configuration" << std::setw(12) << "Sequential";
+    for (auto size : read_sizes) {
+        std::cout << std::setw(12) << ("Rand " + FormatSize(size));
+    }
+    std::cout << "\n";
+    for (const auto &row : rows) {
+        std::cout << std::setw(44) << row.config.Label() << std::setw(12) << row.sequential_mbs;
+        for (auto mbs : row.random_mbs) {
+            std::cout << std::setw(12) << mbs / concurrency;
+        }
+        std::cout << "\n";
+    }
+
+    // Single-stream throughput against the window: with the probe off it
+    // should flatten at window / RTT once the window is smaller than the BDP.
+    std::cout << "\n==== Single-Stream Throughput vs Window (MB/s) ====\n";
+    std::cout << std::setw(12) << "Window" << std::setw(12) << "Max msg";
+    for (const auto &probe : bdp_probes) {
+        std::cout << std::setw(12) << ("bdp " + probe);
+    }
+    std::cout << "\n";
+    for (std::size_t i = 0; i < rows.size(); i += bdp_probes.size()) {
+        const auto &config = rows[i].config;
+        std::cout << std::setw(12) << (config.window_size == 0 ? std::string("default") : FormatSize(config.window_size))
+                  << std::setw(12)
+                  << (config.max_receive_message_size == 0 ? std::string("default")
+                                                           : FormatSize(config.max_receive_message_size));
+        for (std::size_t j = 0; j < bdp_probes.size(); ++j) {
+            std::cout << std::setw(12) << rows[i + j].sequential_mbs;
+        }
+        std::cout << "\n";
+    }
+    std::cout << std::right;
+}
+
+namespace {
+
+void RunCrc32cKernelBenchmark(const std::vector<char> &data, int repetitions) {
+    struct Kernel {
+        std::string name;
+        uint32_t (*fn)(const char *, std::size_t);
+    };
+    std::vector<Kernel> kernels = {{"table (slicing-by-8)", Crc32cTable}};
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("sse4.2")) {
+        kernels.push_back({"sse4.2 (crc32q)", Crc32cSse42});
+    }
+#endif
+    kernels.push_back({"absl (library)", Crc32cAbsl});
+
+    std::cout << "\n==== CRC32C kernels over " << data.size() / static_cast<double>(kMiB)
+              << " MB read buffer, " << repetitions << " repetitions ====\n";
+    auto expected = Crc32cAbsl(data.data(), data.size());
+    for (const auto &kernel : kernels) {
+        uint32_t crc = 0;
+        auto start_time = BenchmarkClock::now();
+        for (int i = 0; i < repetitions; ++i) {
+            crc = kernel.fn(data.data(), data.size());
+        }
+        auto elapsed = std::chrono::duration<double>(BenchmarkClock::now() - start_time).count();
+        double gbs = elapsed > 0 ? data.size() * static_cast<double>(repetitions) / elapsed / 1.0e9 : 0.0;
+        std::cout << std::left << std::setw(24) << kernel.name << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(2) << gbs << " GB/s"
+                  << std::defaultfloat << std::setprecision(6)
+                  << (crc == expected ? "" : "  CHECKSUM MISMATCH") << "\n";
+    }
+}
+
+}  // namespace
+
+void RunHashingBenchmark(int num_iterations,
+                         const std::string &bucket,
+                         const std::string &object_name,
+                         const BenchmarkFlags &flags) {
+    auto kernel_buffer_size = ParseSize(GetFlag(flags, "crc-buffer-size", "64MiB"));
+    int repetitions = std::stoi(GetFlag(flags, "crc-repetitions", "10"));
+
+    struct HashingMode {
+        std::string name;
+        ReadOptions read_options;
+    };
+    const std::vector<HashingMode> modes = {
+        {"crc32c+md5", {false, false}},
+        {"crc32c", {false, true}},
+        {"md5", {true, false}},
+        {"none", {true, true}},
+    };
+
+    auto options = gc::Options{};
+    auto jsonClient = MakeJsonClient(options);
+    auto grpcClient = MakeGrpcClient(options);
+    std::vector<std::pair<std::string, gcs::Client *>> clients = {
+        {"GRPC Client", &grpcClient}, {"Json Client", &jsonClient}};
+
+    auto metadata = jsonClient.GetObjectMetadata(bucket, object_name);
+    if (!metadata) {
+        std::cerr << "Error getting metadata for " << bucket << "/" << object_name << ": " << metadata.status() << "\n";
+        return;
+    }
+    size_t file_size_bytes = metadata->size();
+
+    for (const auto &client : clients) {
+        struct ModeResult {
+            std::string name;
+            AggregateStats stats;
+            double avg_cpu_ms;
+        };
+        std::vector<ModeResult> results;
+
+        for (const auto &mode : modes) {
+            std::cout << "\n" << client.first << "\n==== Sequential read with hashing: " << mode.name << " ====\n";
+            std::vector<int64_t> durations;
+            std::vector<double> cpu_times;
+            for (int i = 1; i <= num_iterations; ++i) {
+                auto cpu_start = ProcessCpuTimeMs();
+                auto result = SequentialReadBenchmark(*client.second, bucket, object_name, kDefaultBufferSize,
+                                                      mode.read_options);
+                auto cpu_ms = ProcessCpuTimeMs() - cpu_start;
+                std::cout << "[" << GetTimestamp() << "] Iteration " << i << ": ";
+                if (result.duration_ms != kErrorDuration) {
+                    std::cout << result.bytes_read / kMiB << " MB in " << result.duration_ms << " ms, "
+                              << cpu_ms << " ms CPU\n";
+                    durations.push_back(result.duration_ms);
+                    cpu_times.push_back(cpu_ms);
+                } else {
+                    std::cout << "Failed.\n";
+                }
+            }
+            double avg_cpu_ms = cpu_times.empty()
+                                    ? 0.0
+                                    : std::accumulate(cpu_times.begin(), cpu_times.end(), 0.0) / cpu_times.size();
+            results.push_back({mode.name, ComputeAggregateStats(file_size_bytes, durations), avg_cpu_ms});
+        }
+
+        double baseline_cpu_ms = results.back().avg_cpu_ms;
+        double file_size_gib = file_size_bytes / static_cast<double>(1024 * kMiB);
+        std::cout << "\n==== Hashing cost (" << client.first << ") ====\n";
+        std::cout << std::left << std::setw(14) << "Hashing" << std::setw(14) << "MB/s"
+                  << std::setw(14) << "CPU ms" << std::setw(16) << "CPU ms/GiB" << "Hashing CPU share\n";
+        for (const auto &r : results) {
+            double share = r.avg_cpu_ms > 0 ? std::max(0.0, 1.0 - baseline_cpu_ms / r.avg_cpu_ms) : 0.0;
+            std::cout << std::setw(14) << r.name << std::setw(14) << r.stats.avg_throughput_mbs
+                      << std::setw(14) << r.avg_cpu_ms
+                      << std::setw(16) << (file_size_gib > 0 ? r.avg_cpu_ms / file_size_gib : 0.0)
+                      << share * 100.0 << " %\n";
+        }
+        std::cout << std::right;
+    }
+
+    std::vector<char> data(std::min(kernel_buffer_size, file_size_bytes));
+    std::size_t bytes_read = 0;
+    if (data.empty() || !ReadRangeInto(jsonClient, bucket, object_name, 0, data.size(), data.data(), bytes_read)) {
+        std::cerr << "Error: could not read the object for the CRC32C kernel benchmark.\n";
+        return;
+    }
+    data.resize(bytes_read);
+    RunCrc32cKernelBenchmark(data, repetitions);
+}
+
+void RunTraceReplay(int num_iterations,
+                    const std::string &bucket,
+                    const std::string &object_name,
+                    const BenchmarkFlags &flags) {
+    auto trace_path = GetFlag(flags, "trace", "");
+    if (trace_path.empty()) {
+        std::cerr << "Error: --mode=trace requires --trace=<file>\n";
+        return;
+    }
+    double speed = std::stod(GetFlag(flags, "trace-speed", "1.0"));
+    int concurrency = std::stoi(GetFlag(flags, "concurrency", "16"));
+    if (speed <= 0 || concurrency <= 0) {
+        std::cerr << "Error: --trace-speed and --concurrency must be positive\n";
+        return;
+    }
+
+    std::vector<ScheduledRead> schedule;
+    if (!LoadReadTrace(trace_path, object_name, speed, schedule)) {
+        return;
+    }
+    std::cout << "\n==== Replaying " << schedule.size() << " requests from " << trace_path
+              << " at " << speed << "x over " << schedule.back().start.count() / 1.0e6
+              << " s, concurrency " << concurrency << " ====\n";
+
+    auto options = gc::Options{};
+    auto jsonClient = MakeJsonClient(options);
+    auto grpcClient = MakeGrpcClient(options);
+    std::vector<std::pair<std::string, gcs::Client *>> clients = {
+        {"GRPC Client", &grpcClient}, {"Json Client", &jsonClient}};
+
+    for (const auto &client : clients) {
+        OpenLoopResult combined;
+        for (int i = 1; i <= num_iterations; ++i) {
+            auto result = RunOpenLoop(*client.second, bucket, schedule, concurrency);
+            std::cout << "[" << GetTimestamp() << "] " << client.first << " iteration " << i << ": "
+                      << result.latencies_ms.size() << " requests in " << result.duration_s << " s, "
+                      << result.failures << " failed\n";
+            combined.latencies_ms.insert(combined.latencies_ms.end(), result.latencies_ms.begin(), result.latencies_ms.end());
+            combined.service_ms.insert(combined.service_ms.end(), result.service_ms.begin(), result.service_ms.end());
+            combined.bytes_read += result.bytes_read;
+            combined.failures += result.failures;
+            combined.duration_s += result.duration_s;
+        }
+        PrintLatencyResults("Trace replay (" + client.first + ")", combined);
+    }
+}
+
+void RunOpenLoopBenchmark(const std::string &bucket,
+                          const std::string &object_name,
+                          const BenchmarkFlags &flags) {
+    auto rate_items = SplitList(GetFlag(flags, "rates", "10,20,50,100,200,400"));
+    std::vector<double> rates;
+    for (const auto &item : rate_items) {
+        rates.push_back(std::stod(item));
+    }
+    auto arrival = GetFlag(flags, "arrival", "poisson");
+    double duration_s = std::stod(GetFlag(flags, "duration", "10"));
+    auto read_size = ParseSize(GetFlag(flags, "read-size", "100KiB"));
+    int concurrency = std::stoi(GetFlag(flags, "concurrency", "64"));
+    double knee_factor = std::stod(GetFlag(flags, "knee-factor", "5"));
+    if (arrival != "poisson" && arrival != "constant") {
+        std::cerr << "Error: --arrival must be poisson or constant\n";
+        return;
+    }
+    if (rates.empty() || duration_s <= 0 || read_size == 0 || concurrency <= 0 ||
+        std::any_of(rates.begin(), rates.end(), [](double r) { return r <= 0; })) {
+        std::cerr << "Error: --rates, --duration, --read-size and --concurrency must be positive\n";
+        return;
+    }
+    std::sort(rates.begin(), rates.end());
+
+    auto options = gc::Options{};
+    auto jsonClient = MakeJsonClient(options);
+    auto grpcClient = MakeGrpcClient(options);
+    std::vector<std::pair<std::string, gcs::Client *>> clients = {
+        {"GRPC Client", &grpcClient}, {"Json Client", &jsonClient}};
+
+    auto metadata = jsonClient.GetObjectMetadata(bucket, object_name);
+    if (!metadata) {
+        std::cerr << "Error getting metadata for " << bucket << "/" << object_name << ": " << metadata.status() << "\n";
+        return;
+    }
+    size_t file_size_bytes = metadata->size();
+    if (file_size_bytes == 0) {
+        std::cerr << "Error: object is empty\n";
+        return;
+    }
+
+    for (const auto &client : clients) {
+        struct RatePoint {
+            double target;
+            double achieved;
+            double p50;
+            double p99;
+            std::size_t failures;
+        };
+        std::vector<RatePoint> points;
+
+        for (auto rate : rates) {
+            auto schedule = MakeOpenLoopSchedule(object_name, file_size_bytes, read_size, rate, duration_s,
+                                                 arrival == "poisson");
+            std::cout << "\n" << client.first << "\n==== Open-loop " << arrival << " arrivals at " << rate
+                      << " req/s for " << duration_s << " s, read size " << read_size / kKiB
+                      << " KB, concurrency " << concurrency << " ====\n";
+            auto result = RunOpenLoop(*client.second, bucket, schedule, concurrency);
+            PrintLatencyResults("Open-loop " + std::to_string(static_cast<int>(rate)) + " req/s (" + client.first + ")",
+                                result);
+
+            auto latencies = result.latencies_ms;
+            std::sort(latencies.begin(), latencies.end());
+            points.push_back({rate, (latencies.size() + result.failures) / result.duration_s,
+                              Percentile(latencies, 0.5), Percentile(latencies, 0.99), result.failures});
+        }
+
+        std::cout << "\n==== Open-loop Rate Sweep (" << client.first << ") ====\n";
+        std::cout << std::left << std::setw(14) << "Target/s" << std::setw(14) << "Achieved/s"
+                  << std::setw(14) << "P50 ms" << std::setw(14) << "P99 ms" << "Failed\n";
+        const RatePoint *knee = nullptr;
+        for (const auto &point : points) {
+            std::cout << std::setw(14) << point.target << std::setw(14) << point.achieved
+                      << std::setw(14) << point.p50 << std::setw(14) << point.p99 << point.failures << "\n";
+            bool saturated = point.achieved < 0.9 * point.target ||
+                             point.p99 > knee_factor * points.front().p99;
+            if (!knee && saturated) knee = &point;
+        }
+        std::cout << std::right;
+        if (knee) {
+            std::cout << "Throughput knee:      " << knee->target << " req/s ("
+                      << knee->target * read_size / static_cast<double>(kMiB) << " MB/s offered)\n";
+        } else {
+            std::cout << "Throughput knee:      not reached (highest rate " << points.back().target << " req/s)\n";
+        }
+    }
+}
+
+void RunInterleavedComparison(int min_iterations,
+                              const std::string &bucket,
+                              const std::string &object_name,
+                              const BenchmarkFlags &flags) {
+    double ci_target = std::stod(GetFlag(flags, "ci-target", "0.05"));
+    int max_iterations = std::stoi(GetFlag(flags, "max-iterations", "50"));
+    auto read_sizes = GetSizeListFlag(flags, "read-sizes", "1MiB,100KiB");
+    int concurrency = std::stoi(GetFlag(flags, "concurrency", "1"));
+    max_iterations = std::max(max_iterations, min_iterations);
+
+    auto options = gc::Options{};
+    auto jsonClient = MakeJsonClient(options);
+    auto grpcClient = MakeGrpcClient(options);
+
+    auto metadata = jsonClient.GetObjectMetadata(bucket, object_name);
+    if (!metadata) {
+        std::cerr << "Error getting metadata for " << bucket << "/" << object_name << ": " << metadata.status() << "\n";
+        return;
+    }
+    size_t file_size_bytes = metadata->size();
+
+    struct Workload {
+        std::string name;
+        std::size_t read_size;  // 0 for sequential
+    };
+    std::vector<Workload> workloads = {{"Sequential", 0}};
+    for (auto size : read_sizes) {
+        workloads.push_back({"Random " + FormatSize(size), size});
+    }
+
+    std::mt19937 gen(std::random_device{}());
+    for (const auto &workload : workloads) {
+        auto run = [&](gcs::Client &client) {
+            if (workload.read_size == 0) {
+                return SequentialReadBenchmark(client, bucket, object_name, kDefaultBufferSize);
+            }
+            return concurrency > 1
+                       ? ConcurrentRandomReadBenchmark(client, bucket, object_name, file_size_bytes,
+                                                       workload.read_size, concurrency)
+                       : RandomReadBenchmark(client, bucket, object_name, file_size_bytes, workload.read_size);
+        };
+
+        std::cout << "\n==== Interleaved " << workload.name << " reads of " << bucket << "/" << object_name
+                  << ", CI target " << ci_target * 100 << "% ====\n";
+        std::vector<int64_t> grpc_durations, json_durations;
+        int attempted = 0;
+        bool converged = false;
+        for (int i = 1; i <= max_iterations && !converged; ++i) {
+            ++attempted;
+            bool grpc_first = std::bernoulli_distribution(0.5)(gen);
+            for (int k = 0; k < 2; ++k) {
+                bool grpc = (k == 0) == grpc_first;
+                auto result = run(grpc ? grpcClient : jsonClient);
+                std::cout << "[" << GetTimestamp() << "] Iteration " << i << " " << (grpc ? "GRPC" : "Json") << ": ";
+                if (result.duration_ms != kErrorDuration) {
+                    std::cout << result.bytes_read / kMiB << " MB in " << result.duration_ms << " ms\n";
+                    (grpc ? grpc_durations : json_durations).push_back(result.duration_ms);
+                } else {
+                    std::cout << "Failed.\n";
+                }
+            }
+            converged = i >= min_iterations && grpc_durations.size() >= 2 && json_durations.size() >= 2 &&
+                        RelativeCIWidth(grpc_durations) <= ci_target && RelativeCIWidth(json_durations) <= ci_target;
+        }
+        if (!converged) {
+            std::cout << "Stopped at --max-iterations=" << max_iterations << " before reaching the CI target\n";
+        }
+
+        auto read_size = workload.read_size;
+        PrintAggregateResults(workload.name + " (GRPC Client, interleaved)", attempted, file_size_bytes, read_size,
+                              grpc_durations);
+        PrintAggregateResults(workload.name + " (Json Client, interleaved)", attempted, file_size_bytes, read_size,
+                              json_durations);
+        PrintComparison("GRPC Client", grpc_durations, "Json Client", json_durations);
+    }
+}
+
+void RunColumnarReadBenchmark(int num_iterations,
+                              const std::string &bucket,
+                              const std::string &object_name,
+                              const BenchmarkFlags &flags) {
+    int row_groups = std::stoi(GetFlag(flags, "row-groups", "8"));
+    int columns = std::stoi(GetFlag(flags, "columns", "20"));
+    int selected = std::stoi(GetFlag(flags, "columns-selected", "5"));
+    auto max_gap = ParseSize(GetFlag(flags, "max-gap", "1MiB"));
+    int concurrency = std::stoi(GetFlag(flags, "concurrency", "4"));
+    if (row_groups <= 0 || columns <= 0 || selected <= 0 || selected > columns || concurrency <= 0) {
+        std::cerr << "Error: need positive --row-groups, --concurrency and 0 < --columns-selected <= --columns\n";
+        return;
+    }
+
+    auto options = gc::Options{};
+    auto jsonClient = MakeJsonClient(options);
+    auto grpcClient = MakeGrpcClient(options);
+    std::vector<std::pair<std::string, gcs::Client *>> clients = {
+        {"GRPC Client", &grpcClient}, {"Json Client", &jsonClient}};
+
+    auto metadata = jsonClient.GetObjectMetadata(bucket, object_name);
+    if (!metadata) {
+        std::cerr << "Error getting metadata for " << bucket << "/" << object_name << ": " << metadata.status() << "\n";
+        return;
+    }
+    size_t file_size_bytes = metadata->size();
+
+    std::mt19937 gen(std::random_device{}());
+    auto layout = MakeColumnarLayout(file_size_bytes, row_groups, columns, gen);
+    std::vector<int> column_ids(columns);
+    std::iota(column_ids.begin(), column_ids.end(), 0);
+    std::shuffle(column_ids.begin(), column_ids.end(), gen);
+    column_ids.resize(selected);
+
+    // Each selected column's chunks are laid out back to back in its buffer.
+    std::map<int, std::vector<char>> column_buffers;
+    std::vector<ReadSlice> slices;
+    std::size_t useful_bytes = 0;
+    for (auto id : column_ids) {
+        std::size_t column_bytes = 0;
+        for (const auto &chunk : layout) {
+            if (chunk.column == id) column_bytes += chunk.length;
+        }
+        column_buffers[id].resize(column_bytes);
+        useful_bytes += column_bytes;
+    }
+    for (auto &entry : column_buffers) {
+        std::size_t position = 0;
+        for (const auto &chunk : layout) {
+            if (chunk.column != entry.first) continue;
+            slices.push_back({chunk.offset, chunk.length, entry.second.data() + position});
+            position += chunk.length;
+        }
+    }
+
+    std::cout << "\n==== Columnar reads of " << bucket << "/" << object_name << ": " << row_groups << " row groups, "
+              << selected << "/" << columns << " columns, " << slices.size() << " chunks, "
+              << useful_bytes / static_cast<double>(kMiB) << " MB selected, concurrency " << concurrency << " ====\n";
+
+    auto buffers_checksum = [&] {
+        uint32_t combined = 0;
+        for (const auto &entry : column_buffers) {
+            combined ^= Crc32cAbsl(entry.second.data(), entry.second.size()) + entry.first;
+        }
+        return combined;
+    };
+
+    // One request per chunk into a scratch buffer, then copied into place.
+    auto per_chunk = [&](gcs::Client &client, ScatterReadStats &stats) {
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> failed{false};
+        auto worker = [&] {
+            std::vector<char> scratch;
+            for (auto i = next++; i < slices.size() && !failed; i = next++) {
+                scratch.resize(std::max(scratch.size(), slices[i].length));
+                std::size_t bytes_read = 0;
+                if (!ReadRangeInto(client, bucket, object_name, slices[i].offset, slices[i].length, scratch.data(),
+                                   bytes_read)) {
+                    failed = true;
+                }
+                std::memcpy(slices[i].destination, scratch.data(), bytes_read);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (int i = 0; i < concurrency; ++i) workers.emplace_back(worker);
+        for (auto &t : workers) t.join();
+        stats.requests += slices.size();
+        stats.bytes_delivered += useful_bytes;
+        return !failed;
+    };
+
+    struct Approach {
+        std::string name;
+        std::function<bool(gcs::Client &, ScatterReadStats &)> run;
+        std::size_t copied_bytes_per_iteration;
+    };
+    std::vector<Approach> approaches = {
+        {"per-chunk + copy", per_chunk, useful_bytes},
+        {"scatter", [&](gcs::Client &client, ScatterReadStats &stats) {
+             return ScatterRead(client, bucket, object_name, slices, 0, concurrency, stats);
+         }, 0},
+        {"scatter gap<=" + FormatSize(max_gap), [&](gcs::Client &client, ScatterReadStats &stats) {
+             return ScatterRead(client, bucket, object_name, slices, max_gap, concurrency, stats);
+         }, 0},
+    };
+
+    for (const auto &client : clients) {
+        struct Row {
+            std::string name;
+            double mbs;
+            double requests;
+            double discarded_mb;
+            double copied_mb;
+            uint32_t checksum;
+        };
+        std::vector<Row> rows;
+        for (const auto &approach : approaches) {
+            std::vector<int64_t> durations;
+            ScatterReadStats stats;
+            uint32_t checksum = 0;
+            for (int i = 1; i <= num_iterations; ++i) {
+                for (auto &entry : column_buffers) std::fill(entry.second.begin(), entry.second.end(), 0);
+                auto start_time = BenchmarkClock::now();
+                bool ok = approach.run(*client.second, stats);
+                auto duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(BenchmarkClock::now() - start_time).count();
+                std::cout << "[" << GetTimestamp() << "] " << client.first << " " << approach.name << " iteration " << i << ": ";
+                if (ok) {
+                    std::cout << useful_bytes / kMiB << " MB in " << duration_ms << " ms\n";
+                    durations.push_back(duration_ms);
+                    checksum = buffers_checksum();
+                } else {
+                    std::cout << "Failed.\n";
+                }
+            }
+            auto aggregate = PrintAggregateResults("Columnar " + approach.name + " (" + client.first + ")",
+                                                   num_iterations, useful_bytes, 0, durations);
+            double n = std::max(num_iterations, 1);
+            rows.push_back({approach.name, aggregate.avg_throughput_mbs, stats.requests / n,
+                            stats.bytes_discarded / n / kMiB, approach.copied_bytes_per_iteration / static_cast<double>(kMiB),
+                            checksum});
+        }
+
+        std::cout << "\n==== Columnar Read Summary (" << client.first << ", per iteration) ====\n";
+        std::cout << std::left << std::setw(24) << "Approach" << std::setw(12) << "MB/s" << std::setw(12) << "Requests"
+                  << std::setw(16) << "Over-read MB" << std::setw(12) << "Copied MB" << "Checksum\n";
+        for (const auto &row : rows) {
+            std::cout << std::setw(24) << row.name << std::setw(12) << row.mbs << std::setw(12) << row.requests
+                      << std::setw(16) << row.discarded_mb << std::setw(12) << row.copied_mb << std::hex
+                      << row.checksum << std::dec
+                      << (row.checksum == rows.front().checksum ? "" : "  MISMATCH") << "\n";
+        }
+        std::cout << std::right;
+    }
+}
+
+void RunMultiRangeBenchmark(int num_iterations,
+                            const std::string &bucket,
+                            const std::string &object_name,
+                            const BenchmarkFlags &flags) {
+    auto read_sizes = GetSizeListFlag(flags, "read-sizes", "100KiB,4MiB");
+    std::size_t range_count = std::stoul(GetFlag(flags, "ranges", "64"));
+    int concurrency = std::stoi(GetFlag(flags, "concurrency", "8"));
+
+    auto options = gc::Options{};
+    auto grpcClient = MakeGrpcClient(options);
+    auto asyncClient = gcs_ex::AsyncClient(options);
+
+    auto metadata = grpcClient.GetObjectMetadata(bucket, object_name);
+    if (!metadata) {
+        std::cerr << "Error getting metadata for " << bucket << "/" << object_name << ": " << metadata.status() << "\n";
+        return;
+    }
+    size_t file_size_bytes = metadata->size();
+
+    std::mt19937 gen(std::random_device{}());
+    for (auto read_size : read_sizes) {
+        if (read_size == 0 || file_size_bytes == 0) continue;
+        std::vector<std::size_t> offsets;
+        for (std::size_t offset = 0; offset < file_size_bytes; offset += read_size) {
+            offsets.push_back(offset);
+        }
+        std::shuffle(offsets.begin(), offsets.end(), gen);
+        offsets.resize(std::min(offsets.size(), range_count));
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        std::size_t total_bytes = 0;
+        for (auto offset : offsets) {
+            ranges.push_back({offset, std::min(read_size, file_size_bytes - offset)});
+            total_bytes += ranges.back().second;
+        }
+
+        struct Approach {
+            std::string name;
+            // Returns the per-range reader for one iteration, or nullptr on setup failure.
+            std::function<RangeReader()> prepare;
+        };
+        std::shared_ptr<gcs_ex::ObjectDescriptor> descriptor;
+        std::vector<Approach> approaches = {
+            {"ReadObject per range", [&]() -> RangeReader {
+                 return [&](std::size_t offset, std::size_t length, char *buffer, std::size_t &bytes_read) {
+                     return ReadRangeInto(grpcClient, bucket, object_name, offset, length, buffer, bytes_read);
+                 };
+             }},
+            {"ReadObjectRange per range", [&]() -> RangeReader {
+                 return [&](std::size_t offset, std::size_t length, char *buffer, std::size_t &bytes_read) {
+                     return AsyncReadRangeInto(asyncClient, bucket, object_name, offset, length, buffer, bytes_read);
+                 };
+             }},
+            {"single stream multi-range", [&]() -> RangeReader {
+                 auto opened = asyncClient.Open(gcs_ex::BucketName(bucket), object_name).get();
+                 if (!opened) {
+                     std::cerr << "Error opening object descriptor: " << opened.status() << "\n";
+                     return nullptr;
+                 }
+                 descriptor = std::make_shared<gcs_ex::ObjectDescriptor>(std::move(*opened));
+                 return [&](std::size_t offset, std::size_t length, char *buffer, std::size_t &bytes_read) {
+                     return ReadDescriptorRange(*descriptor, offset, length, buffer, bytes_read);
+                 };
+             }},
+        };
+
+        struct Row {
+            std::string name;
+            double mbs;
+            double p50_ms;
+            double p99_ms;
+        };
+        std::vector<Row> rows;
+        for (const auto &approach : approaches) {
+            std::cout << "\nGRPC Client\n==== " << approach.name << ": " << ranges.size() << " ranges of "
+                      << read_size / kKiB << " KB, concurrency " << concurrency << " ====\n";
+            std::vector<int64_t> durations;
+            std::vector<double> latencies;
+            for (int i = 1; i <= num_iterations; ++i) {
+                BenchmarkResult result;
+                auto start_time = BenchmarkClock::now();
+                if (auto reader = approach.prepare()) {
+                    result = RunRangeReads(ranges, concurrency, reader, latencies);
+                    if (result.duration_ms != kErrorDuration) {
+                        result.duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            BenchmarkClock::now() - start_time).count();
+                    }
+                }
+                descriptor.reset();
+                std::cout << "[" << GetTimestamp() << "] Iteration " << i << ": ";
+                if (result.duration_ms != kErrorDuration) {
+                    std::cout << result.bytes_read / static_cast<double>(kMiB) << " MB in " << result.duration_ms << " ms\n";
+                    durations.push_back(result.duration_ms);
+                } else {
+                    std::cout << "Failed.\n";
+                }
+            }
+            auto stats = PrintAggregateResults(approach.name + " (GRPC Client)", num_iterations, total_bytes, read_size,
+                                               durations);
+            std::sort(latencies.begin(), latencies.end());
+            rows.push_back({approach.name, stats.avg_throughput_mbs, Percentile(latencies, 0.5), Percentile(latencies, 0.99)});
+        }
+
+        std::cout << "\n==== Multi-range Summary (" << read_size / kKiB << " KB ranges) ====\n";
+        std::cout << std::left << std::setw(30) << "Approach" << std::setw(12) << "MB/s" << std::setw(18)
+                  << "P50 range ms" << "P99 range ms\n";
+        for (const auto &row : rows) {
+            std::cout << std::setw(30) << row.name << std::setw(12) << row.mbs << std::setw(18) << row.p50_ms
+                      << row.p99_ms << "\n";
+        }
+        std::cout << std::right;
+    }
+}
+
+void RunDecompressionBenchmark(int num_iterations,
+                               const std::string &bucket,
+                               const std::string &object_name,
+                               const BenchmarkFlags &flags) {
+    auto chunk_size = ParseSize(GetFlag(flags, "chunk-size", "1MiB"));
+    std::size_t buffers = std::stoul(GetFlag(flags, "buffers", "4"));
+
+    auto options = gc::Options{};
+    auto jsonClient = MakeJsonClient(options);
+    auto grpcClient = MakeGrpcClient(options);
+
+    auto metadata = jsonClient.GetObjectMetadata(bucket, object_name);
+    if (!metadata) {
+        std::cerr << "Error getting metadata for " << bucket << "/" << object_name << ": " << metadata.status() << "\n";
+        return;
+    }
+    auto codec = GetFlag(flags, "codec", "auto");
+    if (codec == "auto") codec = DetectCodec(*metadata, object_name);
+    if (!MakeDecoder(codec, chunk_size)) {
+        std::cerr << "Error: unsupported codec " << codec << " (zstd needs a build with zstd)\n";
+        return;
+    }
+    bool transcodable = metadata->content_encoding() == "gzip";
+
+    struct Variant {
+        std::string client;
+        gcs::Client *handle;
+        std::string name;
+        std::string codec;
+        bool accept_gzip;
+        bool pipelined;
+    };
+    std::vector<Variant> variants;
+    if (transcodable) {
+        variants.push_back({"Json Client", &jsonClient, "service decode", "none", false, false});
+    }
+    for (auto *client : {&grpcClient, &jsonClient}) {
+        auto name = client == &grpcClient ? "GRPC Client" : "Json Client";
+        variants.push_back({name, client, "client decode inline", codec, true, false});
+        variants.push_back({name, client, "client decode pipelined", codec, true, true});
+    }
+
+    std::cout << "\n==== Decompressing reads of " << bucket << "/" << object_name << " (" << codec
+              << ", stored " << metadata->size() / static_cast<double>(kMiB) << " MB), chunk "
+              << chunk_size / kKiB << " KB, " << buffers << " buffers ====\n";
+
+    std::cout << "\n" << std::left << std::setw(14) << "Client" << std::setw(26) << "Variant" << std::setw(14)
+              << "Decoded MB/s" << std::setw(14) << "Wire MB/s" << std::setw(14) << "CPU ms" << std::setw(16)
+              << "Decode CPU ms" << std::setw(16) << "Decoder wait" << "Reader wait\n" << std::right;
+    for (const auto &variant : variants) {
+        std::vector<DecodeResult> results;
+        for (int i = 1; i <= num_iterations; ++i) {
+            auto result = DecompressingReadBenchmark(*variant.handle, bucket, object_name, variant.codec,
+                                                     variant.accept_gzip, variant.pipelined, chunk_size, buffers);
+            if (result.duration_ms != kErrorDuration) results.push_back(result);
+        }
+        std::cout << std::left << std::setw(14) << variant.client << std::setw(26) << variant.name;
+        if (results.empty()) {
+            std::cout << "Failed.\n" << std::right;
+            continue;
+        }
+        auto average = [&](auto field) {
+            double sum = 0.0;
+            for (const auto &r : results) sum += field(r);
+            return sum / results.size();
+        };
+        double seconds = average([](const DecodeResult &r) { return r.duration_ms / 1000.0; });
+        double decoded_mb = average([](const DecodeResult &r) { return r.bytes_decoded / static_cast<double>(kMiB); });
+        double wire_mb = average([](const DecodeResult &r) { return r.bytes_read / static_cast<double>(kMiB); });
+        std::cout << std::setw(14) << (seconds > 0 ? decoded_mb / seconds : 0.0)
+                  << std::setw(14) << (seconds > 0 ? wire_mb / seconds : 0.0)
+                  << std::setw(14) << average([](const DecodeResult &r) { return r.process_cpu_ms; })
+                  << std::setw(16) << average([](const DecodeResult &r) { return r.decoder_cpu_ms; })
+                  << std::setw(16) << average([](const DecodeResult &r) { return r.decoder_wait_ms; })
+                  << average([](const DecodeResult &r) { return r.reader_wait_ms; }) << "\n" << std::right;
+    }
+    std::cout << "Decoder wait is time the decoder sat idle waiting on the network; reader wait is time the\n"
+                 "network thread was blocked on the decoder. Whichever is larger points at the bottleneck.\n";
+}
+
+void RunPipelineBenchmark(int num_iterations,
+                          const std::string &bucket,
+                          const std::string &object_name,
+                          const BenchmarkFlags &flags) {
+    std::vector<std::size_t> buffer_counts;
+    for (const auto &item : SplitList(GetFlag(flags, "buffer-counts", "1,2,4,8"))) {
+        buffer_counts.push_back(std::stoul(item));
+    }
+    auto buffer_sizes = GetSizeListFlag(flags, "buffer-sizes", "256KiB,1MiB,4MiB");
+    auto consumer = GetFlag(flags, "consumer", "spin");
+    double cost_ns_per_kib = std::stod(GetFlag(flags, "cost-ns-per-kib", "200"));
+
+    std::function<void(const char *, std::size_t)> consume;
+    if (consumer == "spin") {
+        consume = [cost_ns_per_kib](const char *data, std::size_t size) { SpinConsume(data, size, cost_ns_per_kib); };
+    } else if (consumer == "crc32c") {
+        consume = [](const char *data, std::size_t size) {
+            volatile uint32_t crc = Crc32cAbsl(data, size);
+            (void)crc;
+        };
+    } else {
+        std::cerr << "Error: --consumer must be spin or crc32c\n";
+        return;
+    }
+
+    auto options = gc::Options{};
+    auto jsonClient = MakeJsonClient(options);
+    auto grpcClient = MakeGrpcClient(options);
+    std::vector<std::pair<std::string, gcs::Client *>> clients = {
+        {"GRPC Client", &grpcClient}, {"Json Client", &jsonClient}};
+
+    for (const auto &client : clients) {
+        struct Row {
+            std::size_t count;
+            std::size_t size;
+            double mbs;
+            double network_ms;
+            double compute_ms;
+            double overlap;  // fraction of the shorter stage hidden behind the longer one
+            std::string bottleneck;
+        };
+        std::vector<Row> rows;
+        for (auto size : buffer_sizes) {
+            for (auto count : buffer_counts) {
+                if (count == 0 || size == 0) continue;
+                std::cout << "\n" << client.first << "\n==== Pipelined read, " << count << " x " << size / kKiB
+                          << " KB buffers, consumer " << consumer << " ====\n";
+                std::vector<PipelineResult> results;
+                for (int i = 1; i <= num_iterations; ++i) {
+                    auto result = PipelinedReadBenchmark(*client.second, bucket, object_name, count, size, consume);
+                    std::cout << "[" << GetTimestamp() << "] Iteration " << i << ": ";
+                    if (result.duration_ms == kErrorDuration) {
+                        std::cout << "Failed.\n";
+                        continue;
+                    }
+                    std::cout << result.bytes_read / kMiB << " MB in " << result.duration_ms << " ms (network "
+                              << result.network_ms << " ms, compute " << result.compute_ms << " ms)\n";
+                    results.push_back(result);
+                }
+                if (results.empty()) continue;
+
+                double n = results.size();
+                double wall = 0, network = 0, compute = 0, mb = 0, producer_wait = 0, consumer_wait = 0;
+                for (const auto &r : results) {
+                    wall += r.duration_ms / n;
+                    network += r.network_ms / n;
+                    compute += r.compute_ms / n;
+                    mb += r.bytes_read / static_cast<double>(kMiB) / n;
+                    producer_wait += r.producer_wait_ms / n;
+                    consumer_wait += r.consumer_wait_ms / n;
+                }
+                double shorter = std::min(network, compute);
+                double overlap = shorter > 0 ? std::clamp((network + compute - wall) / shorter, 0.0, 1.0) : 0.0;
+                rows.push_back({count, size, wall > 0 ? mb / (wall / 1000.0) : 0.0, network, compute, overlap,
+                                consumer_wait > producer_wait ? "network" : "consumer"});
+            }
+        }
+        if (rows.empty()) continue;
+
+        std::cout << "\n==== Pipeline Sweep (" << client.first << ", consumer " << consumer << ") ====\n";
+        std::cout << std::left << std::setw(10) << "Buffers" << std::setw(12) << "Size" << std::setw(12) << "MB/s"
+                  << std::setw(14) << "Network ms" << std::setw(14) << "Compute ms" << std::setw(12) << "Overlap"
+                  << "Bottleneck\n";
+        for (const auto &row : rows) {
+            std::cout << std::setw(10) << row.count << std::setw(12) << FormatSize(row.size) << std::setw(12)
+                      << row.mbs << std::setw(14) << row.network_ms << std::setw(14) << row.compute_ms
+                      << std::setw(12) << (std::to_string(static_cast<int>(row.overlap * 100)) + "%")
+                      << row.bottleneck << "\n";
+        }
+        std::cout << std::right;
+
+        // Smallest memory footprint within 5% of the best throughput.
+        auto best = std::max_element(rows.begin(), rows.end(), [](const Row &a, const Row &b) { return a.mbs < b.mbs; });
+        const Row *recommended = &*best;
+        for (const auto &row : rows) {
+            if (row.mbs >= 0.95 * best->mbs && row.count * row.size < recommended->count * recommended->size) {
+                recommended = &row;
+            }
+        }
+        std::cout << "Recommended:          " << recommended->count << " x " << FormatSize(recommended->size)
+                  << " (" << recommended->mbs << " MB/s, best " << best->mbs << " MB/s)\n";
+    }
+}
+
+void RunMemoryBenchmark(int num_iterations,
+                        const std::string &bucket,
+                        const std::string &object_name,
+                        const BenchmarkFlags &flags) {
+    std::vector<int> concurrency_levels;
+    for (const auto &item : SplitList(GetFlag(flags, "concurrency-list", "1,4,16,64"))) {
+        concurrency_levels.push_back(std::stoi(item));
+    }
+    auto read_size = ParseSize(GetFlag(flags, "read-size", "1MiB"));
+
+    auto options = gc::Options{};
+    auto jsonClient = MakeJsonClient(options);
+    auto grpcClient = MakeGrpcClient(options);
+    std::vector<std::pair<std::string, gcs::Client *>> clients = {
+        {"GRPC Client", &grpcClient}, {"Json Client", &jsonClient}};
+
+    auto metadata = jsonClient.GetObjectMetadata(bucket, object_name);
+    if (!metadata) {
+        std::cerr << "Error getting metadata for " << bucket << "/" << object_name << ": " << metadata.status() << "\n";
+        return;
+    }
+    size_t file_size_bytes = metadata->size();
+
+    for (const auto &client : clients) {
+        struct Row {
+            int concurrency;
+            double mbs;
+            MemorySampler::Summary memory;
+            std::size_t bytes_read;
+        };
+        std::vector<Row> rows;
+        for (auto concurrency : concurrency_levels) {
+            if (concurrency <= 0) continue;
+            std::cout << "\n" << client.first << "\n==== Memory at concurrency " << concurrency << ", read size "
+                      << read_size / kKiB << " KB ====\n";
+            MemorySampler sampler;
+            sampler.Start();
+            std::vector<int64_t> durations;
+            std::size_t bytes_read = 0;
+            for (int i = 1; i <= num_iterations; ++i) {
+                auto result = ConcurrentRandomReadBenchmark(*client.second, bucket, object_name, file_size_bytes,
+                                                            read_size, concurrency);
+                bytes_read += result.bytes_read;
+                std::cout << "[" << GetTimestamp() << "] Iteration " << i << ": ";
+                if (result.duration_ms != kErrorDuration) {
+                    std::cout << result.bytes_read / kMiB << " MB in " << result.duration_ms << " ms, RSS "
+                              << CurrentRssBytes() / kMiB << " MB\n";
+                    durations.push_back(result.duration_ms);
+                } else {
+                    std::cout << "Failed.\n";
+                }
+            }
+            auto memory = sampler.Stop();
+            PrintMemorySummary(memory, bytes_read);
+            rows.push_back({concurrency, ComputeAggregateStats(file_size_bytes, durations).avg_throughput_mbs, memory,
+                            bytes_read});
+        }
+
+        std::cout << "\n==== Memory vs Concurrency (" << client.first << ", MB) ====\n";
+        std::cout << std::left << std::setw(13) << "Concurrency" << std::setw(10) << "MB/s" << std::setw(10)
+                  << "Mean RSS" << std::setw(10) << "Peak RSS" << std::setw(10) << "Heap" << std::setw(10) << "Held"
+                  << std::setw(12) << "Allocs/MB" << "KB alloc/MB\n";
+        for (const auto &row : rows) {
+            std::cout << std::setw(13) << row.concurrency << std::setw(10) << row.mbs << std::setw(10)
+                      << row.memory.mean_rss / kMiB << std::setw(10) << row.memory.peak_rss / kMiB << std::setw(10)
+                      << row.memory.allocator.in_use_bytes / kMiB << std::setw(10)
+                      << row.memory.allocator.held_bytes / kMiB << std::setw(12);
+#ifdef GCS_BENCHMARK_COUNT_ALLOCATIONS
+            double mb_read = std::max(row.bytes_read / static_cast<double>(kMiB), 1e-9);
+            std::cout << row.memory.allocations / mb_read << row.memory.allocated_bytes / mb_read / kKiB;
+#else
+            std::cout << "n/a" << "n/a";
+#endif
+            std::cout << "\n";
+        }
+        std::cout << std::right;
+    }
+}
+
+void RunRawGrpcBenchmark(int num_iterations,
+                         const std::string &bucket,
+                         const std::string &object_name,
+                         const BenchmarkFlags &flags) {
+    std::size_t arena_reset = std::stoul(GetFlag(flags, "arena-reset", "16"));
+    bool validate_crc32c = GetFlag(flags, "raw-crc32c", "true") == "true";
+
+    auto grpcClient = MakeGrpcClient();
+    RawGrpcReader raw(MakeRawGrpcChannel(flags), bucket, validate_crc32c);
+    if (RawGrpcTarget(flags) != SelectedTransport().GrpcTarget()) {
+        std::cout << "Note: the raw reader targets " << RawGrpcTarget(flags) << " and the stock client "
+                  << SelectedTransport().GrpcTarget() << "; the gap includes the difference between them.\n";
+    }
+    std::vector<char> buffer(kDefaultBufferSize);
+
+    auto metadata = grpcClient.GetObjectMetadata(bucket, object_name);
+    if (!metadata) {
+        std::cerr << "Error getting metadata for " << bucket << "/" << object_name << ": " << metadata.status() << "\n";
+        return;
+    }
+    size_t file_size_bytes = metadata->size();
+
+    using Mode = RawGrpcReader::MessageMode;
+    auto raw_variant = [&](Mode mode, bool copy) {
+        return [&, mode, copy] {
+            BenchmarkResult result;
+            auto start_time = BenchmarkClock::now();
+            std::size_t bytes_read = 0;
+            if (raw.Read(object_name, 0, 0, mode, copy ? buffer.data() : nullptr, buffer.size(), bytes_read,
+                         std::max<std::size_t>(arena_reset, 1))) {
+                result.duration_ms =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(BenchmarkClock::now() - start_time).count();
+            }
+            result.bytes_read = bytes_read;
+            return result;
+        };
+    };
+    std::vector<std::pair<std::string, std::function<BenchmarkResult()>>> variants = {
+        {"stock MakeGrpcClient", [&] { return SequentialReadBenchmark(grpcClient, bucket, object_name); }},
+        {"raw fresh messages", raw_variant(Mode::kFresh, false)},
+        {"raw reused message", raw_variant(Mode::kReuse, false)},
+        {"raw reuse + copy", raw_variant(Mode::kReuse, true)},
+        {"raw arena", raw_variant(Mode::kArena, false)},
+    };
+
+    struct Row {
+        std::string name;
+        double mbs;
+        double cpu_ms_per_gib;
+        double allocations_per_mb;
+    };
+    std::vector<Row> rows;
+    for (const auto &variant : variants) {
+        std::cout << "\nGRPC Client\n==== Sequential read, " << variant.first << " ====\n";
+        std::vector<int64_t> durations;
+        double cpu_ms = 0.0;
+        std::size_t bytes = 0;
+        auto allocations_start = g_allocations.allocations.load();
+        for (int i = 1; i <= num_iterations; ++i) {
+            auto cpu_start = ProcessCpuTimeMs();
+            auto result = variant.second();
+            cpu_ms += ProcessCpuTimeMs() - cpu_start;
+            bytes += result.bytes_read;
+            std::cout << "[" << GetTimestamp() << "] Iteration " << i << ": ";
+            if (result.duration_ms != kErrorDuration) {
+                std::cout << result.bytes_read / kMiB << " MB in " << result.duration_ms << " ms\n";
+                durations.push_back(result.duration_ms);
+            } else {
+                std::cout << "Failed.\n";
+            }
+        }
+        auto allocations = g_allocations.allocations.load() - allocations_start;
+        auto stats = PrintAggregateResults(variant.first + " (GRPC Client)", num_iterations, file_size_bytes, 0, durations);
+        double gib = bytes / static_cast<double>(1024 * kMiB);
+        double mb = bytes / static_cast<double>(kMiB);
+        rows.push_back({variant.first, stats.avg_throughput_mbs, gib > 0 ? cpu_ms / gib : 0.0,
+                        mb > 0 ? allocations / mb : 0.0});
+    }
+
+    std::cout << "\n==== gRPC Read Path Summary ====\n";
+    std::cout << std::left << std::setw(24) << "Variant" << std::setw(12) << "MB/s" << std::setw(16) << "CPU ms/GiB"
+              << "Allocs/MB\n";
+    for (const auto &row : rows) {
+        std::cout << std::setw(24) << row.name << std::setw(12) << row.mbs << std::setw(16) << row.cpu_ms_per_gib;
+#ifdef GCS_BENCHMARK_COUNT_ALLOCATIONS
+        std::cout << row.allocations_per_mb;
+#else
+        std::cout << "n/a";
+#endif
+        std::cout << "\n";
+    }
+    std::cout << std::right;
+    // The stock client validates CRC32C by default; only with the raw reader
+    // doing the same is the gap the library's own overhead.
+    std::cout << (validate_crc32c ? "Raw readers validate CRC32C, as the stock client does.\n"
+                                  : "Raw readers skip CRC32C (--raw-crc32c=false); the stock client's figures include "
+                                    "checksum CPU.\n");
+}
+
+void RunTracingBenchmark(int num_iterations,
+                         const std::string &bucket,
+                         const std::string &object_name,
+                         const BenchmarkFlags &flags) {
+#ifndef GCS_BENCHMARK_HAVE_OPENTELEMETRY
+    (void)num_iterations;
+    (void)bucket;
+    (void)object_name;
+    (void)flags;
+    std::cerr << "Error: built without OpenTelemetry; install opentelemetry-cpp and rebuild.\n";
+#else
+    auto samplings = SplitList(GetFlag(flags, "trace-sample-ratios", "off,0,0.01,1"));
+    auto read_size = ParseSize(GetFlag(flags, "read-size", "1MiB"));
+    int reads_per_iteration = std::stoi(GetFlag(flags, "reads-per-iteration", "16"));
+    auto span_file_name = GetFlag(flags, "span-file", "");
+    std::ofstream span_file;
+    if (!span_file_name.empty()) {
+        span_file.open(span_file_name);
+        if (!span_file) {
+            std::cerr << "Error: cannot write span file " << span_file_name << "\n";
+            return;
+        }
+    }
+
+    auto metadata = MakeJsonClient().GetObjectMetadata(bucket, object_name);
+    if (!metadata) {
+        std::cerr << "Error getting metadata for " << bucket << "/" << object_name << ": " << metadata.status() << "\n";
+        return;
+    }
+    size_t file_size_bytes = metadata->size();
+
+    struct Row {
+        std::string client;
+        std::string sampling;
+        double mbs;
+        double mean_ms;
+        double p99_ms;
+        double cpu_ms_per_read;
+    };
+    std::vector<Row> rows;
+    for (const auto &sampling : samplings) {
+        bool enabled = sampling != "off";
+        auto store = std::make_shared<SpanStore>();
+        store->file = span_file.is_open() ? &span_file : nullptr;
+        otel_sdk::TracerProvider *sdk_provider = nullptr;
+        if (enabled) {
+            double ratio = std::stod(sampling);
+            sdk_provider = new otel_sdk::TracerProvider(
+                otel_sdk::SimpleSpanProcessorFactory::Create(std::make_unique<RecordingSpanExporter>(store)),
+                otel::sdk::resource::Resource::Create({}),
+                std::make_unique<otel_sdk::ParentBasedSampler>(
+                    std::make_shared<otel_sdk::TraceIdRatioBasedSampler>(ratio)));
+            otel::trace::Provider::SetTracerProvider(otel::nostd::shared_ptr<otel::trace::TracerProvider>(sdk_provider));
+        } else {
+            otel::trace::Provider::SetTracerProvider(
+                otel::nostd::shared_ptr<otel::trace::TracerProvider>(new otel::trace::NoopTracerProvider));
+        }
+
+        auto options = gc::Options{}.set<gc::OpenTelemetryTracingOption>(enabled);
+        auto jsonClient = MakeJsonClient(options);
+        auto grpcClient = MakeGrpcClient(options);
+        std::vector<std::pair<std::string, gcs::Client *>> clients = {{"GRPC Client", &grpcClient},
+                                                                      {"Json Client", &jsonClient}};
+        for (const auto &client : clients) {
+            std::cout << "\n" << client.first << "\n==== Traced random reads, " << FormatSize(read_size)
+                      << ", sampling " << sampling << " ====\n";
+            double cpu_ms = 0.0;
+            auto result = RunTracedReads(*client.second, client.first, sampling, num_iterations, reads_per_iteration,
+                                         bucket, object_name, file_size_bytes, read_size, cpu_ms);
+            auto latencies = result.latencies_ms;
+            std::sort(latencies.begin(), latencies.end());
+            auto reads = latencies.size() + result.failures;
+            rows.push_back({client.first, sampling,
+                            result.duration_s > 0 ? result.bytes_read / static_cast<double>(kMiB) / result.duration_s
+                                                  : 0.0,
+                            Mean(latencies), Percentile(latencies, 0.99), reads > 0 ? cpu_ms / reads : 0.0});
+            if (!enabled) continue;
+
+            sdk_provider->ForceFlush();
+            std::vector<RecordedSpan> spans;
+            {
+                std::lock_guard<std::mutex> lock(store->mu);
+                spans.swap(store->spans);
+            }
+            PrintSpanBreakdown(client.first + " sampling " + sampling, spans);
+        }
+    }
+    otel::trace::Provider::SetTracerProvider(
+        otel::nostd::shared_ptr<otel::trace::TracerProvider>(new otel::trace::NoopTracerProvider));
+
+    std::cout << "\n==== OpenTelemetry Tracing Overhead ====\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(14) << "Client" << std::setw(10) << "Sampling" << std::setw(10) << "MB/s"
+              << std::setw(11) << "Mean ms" << std::setw(11) << "p99 ms" << std::setw(14) << "CPU ms/read"
+              << "Overhead (latency / CPU)\n";
+    for (const auto &row : rows) {
+        std::cout << std::setw(14) << row.client << std::setw(10) << row.sampling << std::setw(10) << row.mbs
+                  << std::setw(11) << row.mean_ms << std::setw(11) << row.p99_ms << std::setw(14)
+                  << row.cpu_ms_per_read;
+        auto baseline = std::find_if(rows.begin(), rows.end(),
+                                     [&](const Row &r) { return r.client == row.client && r.sampling == "off"; });
+        if (baseline != rows.end() && &*baseline != &row && baseline->mean_ms > 0 && baseline->cpu_ms_per_read > 0) {
+            std::cout << std::showpos << 100.0 * (row.mean_ms / baseline->mean_ms - 1) << "% / "
+                      << 100.0 * (row.cpu_ms_per_read / baseline->cpu_ms_per_read - 1) << "%" << std::noshowpos;
+        } else {
+            std::cout << "-";
+        }
+        std::cout << "\n";
+    }
+    std::cout << std::right << std::defaultfloat;
+#endif
+}
+
+void RunBackendComparison(int num_iterations,
+                          const std::string &bucket,
+                          const std::string &object_name,
+                          const BenchmarkFlags &flags) {
+    auto names = SplitList(GetFlag(flags, "backends", "json,grpc"));
+    auto read_sizes = GetSizeListFlag(flags, "read-sizes", "1MiB,100KiB");
+    int concurrency = std::stoi(GetFlag(flags, "concurrency", "1"));
+    PhaseInstrumentation instrumentation;
+    if (!ParsePhaseInstrumentation(flags, instrumentation)) return;
+
+    // Create every backend up front so a bad setting fails before any reads.
+    std::vector<std::unique_ptr<StorageBackend>> backends;
+    for (const auto &name : names) {
+        auto backend = MakeBackend(name, flags);
+        if (!backend) return;
+        backends.push_back(std::move(backend));
+    }
+
+    struct Row {
+        std::string backend;
+        double sequential_mbs;
+        std::vector<double> random_mbs;
+        std::vector<double> random_cpu_us;  // process CPU per request
+    };
+    std::vector<Row> rows;
+    for (auto &backend : backends) {
+        Row row{backend->Name(), 0.0, {}, {}};
+        row.sequential_mbs =
+            RunSequentialBenchmark(num_iterations, *backend, bucket, object_name, backend->Name(), instrumentation)
+                .avg_throughput_mbs;
+        for (auto size : read_sizes) {
+            auto cpu_start = ProcessCpuTimeMs();
+            auto requests_start = g_progress.requests.load();
+            row.random_mbs.push_back(RunRandomBenchmark(num_iterations, *backend, bucket, object_name, size,
+                                                        backend->Name(), concurrency, instrumentation)
+                                         .avg_throughput_mbs);
+            auto requests = g_progress.requests.load() - requests_start;
+            row.random_cpu_us.push_back(requests > 0 ? 1000.0 * (ProcessCpuTimeMs() - cpu_start) / requests : 0.0);
+        }
+        backend->PrintTransportStats();
+        rows.push_back(std::move(row));
+    }
+
+    std::cout << "\n==== Backend Comparison (avg MB/s, random concurrency " << concurrency << ") ====\n";
+    std::cout << std::left << std::setw(10) << "Backend" << std::setw(12) << "Sequential";
+    for (auto size : read_sizes) {
+        std::cout << std::setw(12) << ("Rand " + FormatSize(size));
+    }
+    std::cout << "\n";
+    for (const auto &row : rows) {
+        std::cout << std::setw(10) << row.backend << std::setw(12) << row.sequential_mbs;
+        for (auto mbs : row.random_mbs) {
+            std::cout << std::setw(12) << mbs;
+        }
+        std::cout << "\n";
+    }
+
+    // CPU the whole process spends per random read, the number a cheaper
+    // transport (fewer syscalls, no library layers) should move.
+    std::cout << "\n==== Process CPU per Random Read (us) ====\n";
+    std::cout << std::setw(10) << "Backend";
+    for (auto size : read_sizes) {
+        std::cout << std::setw(12) << ("Rand " + FormatSize(size));
+    }
+    std::cout << "\n";
+    for (const auto &row : rows) {
+        std::cout << std::setw(10) << row.backend;
+        for (auto cpu_us : row.random_cpu_us) {
+            std::cout << std::setw(12) << cpu_us;
+        }
+        std::cout << "\n";
+    }
+
+    // Throughput a specialized reader gains over each client library when
+    // both ran (the cost of the library's layers above the protocol), and
+    // io_uring over the libcurl multi reader (the cost of its syscalls).
+    auto find_row = [&](const std::string &name) {
+        return std::find_if(rows.begin(), rows.end(), [&](const Row &row) { return row.backend == name; });
+    };
+    std::vector<std::pair<std::string, std::string>> pairs = {
+        {"json", "raw-curl"}, {"grpc", "raw-grpc"}, {"raw-curl", "uring"}};
+    // A raw reader sent elsewhere than its client library measures a different
+    // service, not the library's overhead.
+    const auto &selection = SelectedTransport();
+    std::map<std::string, std::pair<std::string, std::string>> endpoints = {
+        {"raw-curl", {RawCurlEndpoint(flags), selection.JsonEndpoint()}},
+        {"raw-grpc", {RawGrpcTarget(flags), selection.GrpcTarget()}}};
+    bool header_printed = false;
+    for (const auto &pair : pairs) {
+        auto library = find_row(pair.first);
+        auto raw = find_row(pair.second);
+        if (library == rows.end() || raw == rows.end()) continue;
+        auto endpoint = endpoints.find(pair.second);
+        if (endpoint != endpoints.end() && endpoint->second.first != endpoint->second.second) {
+            std::cout << "\nNo " << pair.second << " vs " << pair.first << " gain: " << pair.second << " read from "
+                      << endpoint->second.first << ", " << pair.first << " from " << endpoint->second.second << "\n";
+            continue;
+        }
+        if (!header_printed) {
+            std::cout << "\n==== Raw Reader Gain Over Baseline (throughput) ====\n";
+            std::cout << std::setw(20) << "Comparison" << std::setw(12) << "Sequential";
+            for (auto size : read_sizes) {
+                std::cout << std::setw(12) << ("Rand " + FormatSize(size));
+            }
+            std::cout << "\n";
+            header_printed = true;
+        }
+        auto gain = [](double library_mbs, double raw_mbs) {
+            std::ostringstream out;
+            if (library_mbs > 0) {
+                out << std::showpos << std::fixed << std::setprecision(1) << 100.0 * (raw_mbs / library_mbs - 1) << "%";
+            } else {
+                out << "-";
+            }
+            return out.str();
+        };
+        std::cout << std::setw(20) << (pair.second + " vs " + pair.first) << std::setw(12)
+                  << gain(library->sequential_mbs, raw->sequential_mbs);
+        for (std::size_t i = 0; i < read_sizes.size(); ++i) {
+            std::cout << std::setw(12) << gain(library->random_mbs[i], raw->random_mbs[i]);
+        }
+        std::cout << "\n";
+    }
+    if (find_row("grpc") != rows.end() && find_row("raw-grpc") != rows.end()) {
+        std::cout << (GetFlag(flags, "raw-crc32c", "true") == "true"
+                          ? "raw-grpc validates CRC32C, as the grpc client does.\n"
+                          : "raw-grpc skips CRC32C (--raw-crc32c=false); its gain includes the grpc client's "
+                            "checksum CPU.\n");
+    }
+    std::cout << std::right;
+}
+
+void RunTlsBenchmark(int num_iterations,
+                     const std::string &bucket,
+                     const std::string &object_name,
+                     const BenchmarkFlags &flags) {
+    int handshakes = std::stoi(GetFlag(flags, "handshakes", "50"));
+    const char *emulator = std::getenv("STORAGE_EMULATOR_HOST");
+    auto json_upstream = GetFlag(flags, "tls-json-upstream", emulator == nullptr ? "" : emulator);
+    if (json_upstream.compare(0, 7, "http://") == 0) json_upstream = json_upstream.substr(7);
+    while (!json_upstream.empty() && json_upstream.back() == '/') json_upstream.pop_back();
+    auto grpc_upstream = GetFlag(flags, "tls-grpc-upstream", "");
+    auto ciphers = SplitList(GetFlag(flags, "tls-ciphers", "aes-128-gcm,aes-256-gcm,chacha20-poly1305"));
+    auto record_size = ParseSize(GetFlag(flags, "record-size", "16KiB"));
+    auto cipher_bytes = ParseSize(GetFlag(flags, "cipher-bytes", "256MiB"));
+
+    auto identity = MakeSelfSignedIdentity(GetFlag(flags, "tls-key", "ec"));
+    if (!identity) return;
+    TlsProxy json_proxy(*identity, json_upstream, "http/1.1");
+    if (!json_proxy.Start()) return;
+
+    // Bare OpenSSL handshakes against the stand-in: the floor any client
+    // pays per new connection, and what resumption saves of it.
+    struct HandshakeRow {
+        std::string name;
+        HandshakeStats stats;
+        double server_cpu_ms;
+    };
+    std::vector<HandshakeRow> handshake_rows;
+    for (int version : {TLS1_2_VERSION, TLS1_3_VERSION}) {
+        for (bool resume : {false, true}) {
+            auto before = json_proxy.Snapshot();
+            auto stats = MeasureHandshakes(json_proxy.Port(), identity->certificate_file, version, resume, handshakes);
+            auto after = json_proxy.Snapshot();
+            auto accepted = after.handshakes - before.handshakes;
+            handshake_rows.push_back(
+                {std::string(version == TLS1_2_VERSION ? "TLS1.2" : "TLS1.3") + (resume ? " resumed" : " full"),
+                 std::move(stats),
+                 accepted > 0 ? (after.handshake_cpu_ms - before.handshake_cpu_ms) / accepted : 0.0});
+        }
+    }
+    std::cout << "\n==== TLS Handshakes (" << GetFlag(flags, "tls-key", "ec") << " key, " << handshakes
+              << " per row) ====\n";
+    std::cout << std::left << std::setw(16) << "Handshake" << std::setw(10) << "Mean ms" << std::setw(10) << "P50 ms"
+              << std::setw(10) << "P99 ms" << std::setw(16) << "Client CPU ms" << std::setw(16) << "Server CPU ms"
+              << "Resumed\n";
+    for (auto &row : handshake_rows) {
+        auto &latencies = row.stats.latencies_ms;
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << std::setw(16) << row.name << std::setw(10) << Mean(latencies) << std::setw(10) << Percentile(latencies, 0.5)
+                  << std::setw(10) << Percentile(latencies, 0.99) << std::setw(16)
+                  << (row.stats.succeeded > 0 ? row.stats.client_cpu_ms / row.stats.succeeded : 0.0) << std::setw(16)
+                  << row.server_cpu_ms << row.stats.resumed << "/" << row.stats.succeeded << "\n";
+    }
+    std::cout << std::right;
+
+    // The client libraries through the stand-in: a new client per request
+    // (cold) pays connection setup every time, one reused client (warm) only
+    // once. The proxy's counters show how often the library resumed.
+    struct ClientRow {
+        std::string client;
+        std::string mode;
+        double mean_ms;
+        double p99_ms;
+        double client_cpu_ms;  // per request, the proxy's threads excluded
+        double proxy_cpu_ms;
+        uint64_t handshakes;
+        uint64_t resumed;
+    };
+    std::vector<ClientRow> client_rows;
+    std::unique_ptr<TlsProxy> grpc_proxy;
+    std::vector<std::pair<std::string, std::function<gcs::Client()>>> clients;
+    if (!json_upstream.empty()) {
+        clients.emplace_back("JSON", [&] {
+            return MakeJsonClient(gc::Options{}
+                                      .set<gcs::RestEndpointOption>("https://127.0.0.1:" +
+                                                                    std::to_string(json_proxy.Port()))
+                                      .set<gc::CARootsFilePathOption>(identity->certificate_file)
+                                      .set<gc::UnifiedCredentialsOption>(gc::MakeInsecureCredentials()));
+        });
+    } else {
+        std::cout << "\nSkipping client handshakes: set STORAGE_EMULATOR_HOST or --tls-json-upstream\n";
+    }
+    if (!grpc_upstream.empty()) {
+        grpc_proxy = std::make_unique<TlsProxy>(*identity, grpc_upstream, "h2");
+        if (!grpc_proxy->Start()) return;
+        clients.emplace_back("GRPC", [&] {
+            grpc::SslCredentialsOptions ssl;
+            ssl.pem_root_certs = identity->certificate_pem;
+            return MakeGrpcClient(gc::Options{}
+                                      .set<gc::EndpointOption>("127.0.0.1:" + std::to_string(grpc_proxy->Port()))
+                                      .set<gc::GrpcCredentialOption>(grpc::SslCredentials(ssl)));
+        });
+    }
+    for (auto &entry : clients) {
+        auto &proxy = entry.first == "GRPC" ? *grpc_proxy : json_proxy;
+        for (bool cold : {true, false}) {
+            std::vector<double> latencies;
+            double process_cpu_ms = 0.0;
+            auto before = proxy.Snapshot();
+            auto measure = [&](gcs::Client &client) {
+                auto cpu_start = ProcessCpuTimeMs();
+                auto start_time = BenchmarkClock::now();
+                auto metadata = client.GetObjectMetadata(bucket, object_name);
+                auto elapsed = std::chrono::duration<double, std::milli>(BenchmarkClock::now() - start_time).count();
+                process_cpu_ms += ProcessCpuTimeMs() - cpu_start;
+                if (!metadata) {
+                    std::cerr << "Error getting metadata through the TLS proxy: " << metadata.status() << "\n";
+                    return;
+                }
+                latencies.push_back(elapsed);
+            };
+            if (cold) {
+                for (int i = 0; i < num_iterations; ++i) {
+                    auto client = entry.second();
+                    measure(client);
+                }
+            } else {
+                auto client = entry.second();
+                client.GetObjectMetadata(bucket, object_name);  // connects
+                before = proxy.Snapshot();
+                for (int i = 0; i < num_iterations; ++i) measure(client);
+            }
+            auto after = proxy.Snapshot();
+            std::sort(latencies.begin(), latencies.end());
+            double requests = std::max<std::size_t>(latencies.size(), 1);
+            double proxy_cpu_ms = after.cpu_ms - before.cpu_ms;
+            client_rows.push_back({entry.first, cold ? "cold" : "warm", Mean(latencies), Percentile(latencies, 0.99), (process_cpu_ms - proxy_cpu_ms) / requests,
+                                   proxy_cpu_ms / requests, after.handshakes - before.handshakes,
+                                   after.resumed - before.resumed});
+        }
+    }
+    if (!client_rows.empty()) {
+        std::cout << "\n==== Client Connection Cost (GetObjectMetadata, " << num_iterations << " per row) ====\n";
+        std::cout << std::left << std::setw(8) << "Client" << std::setw(8) << "Clients" << std::setw(10) << "Mean ms"
+                  << std::setw(10) << "P99 ms" << std::setw(16) << "Client CPU ms" << std::setw(16) << "Proxy CPU ms"
+                  << std::setw(12) << "Handshakes" << "Resumed\n";
+        for (const auto &row : client_rows) {
+            std::cout << std::setw(8) << row.client << std::setw(8) << row.mode << std::setw(10) << row.mean_ms
+                      << std::setw(10) << row.p99_ms << std::setw(16) << row.client_cpu_ms << std::setw(16)
+                      << row.proxy_cpu_ms << std::setw(12) << row.handshakes << row.resumed << "\n";
+        }
+        std::cout << "\n==== Connection Setup Cost (cold - warm, per request) ====\n";
+        std::cout << std::setw(8) << "Client" << std::setw(12) << "Latency ms" << "Client CPU ms\n";
+        for (std::size_t i = 0; i + 1 < client_rows.size(); i += 2) {
+            const auto &cold = client_rows[i];
+            const auto &warm = client_rows[i + 1];
+            std::cout << std::setw(8) << cold.client << std::setw(12) << cold.mean_ms - warm.mean_ms
+                      << cold.client_cpu_ms - warm.client_cpu_ms << "\n";
+        }
+        std::cout << std::right;
+    }
+
+    // Record protection cost: what a core can seal and open at TLS record
+    // size, i.e. how many cores each cipher needs at NIC line rate.
+    std::cout << "\n==== AEAD Record Cost (" << FormatSize(record_size) << " records, one core) ====\n";
+    std::cout << std::left << std::setw(20) << "Cipher" << std::setw(14) << "Seal MB/s" << std::setw(14) << "Open MB/s"
+              << std::setw(14) << "Open ns/B" << "Cores @100Gb/s\n";
+    for (const auto &cipher : ciphers) {
+        CipherThroughput throughput;
+        if (!MeasureCipherThroughput(cipher, record_size, cipher_bytes, throughput)) continue;
+        std::cout << std::setw(20) << cipher << std::setw(14) << throughput.encrypt_mbs << std::setw(14)
+                  << throughput.decrypt_mbs << std::setw(14) << throughput.decrypt_cpu_ns_per_byte
+                  << throughput.decrypt_cpu_ns_per_byte * 12.5 << "\n";
+    }
+    std::cout << std::right;
+
+    // The same comparison end to end: whole-object reads with the JSON client
+    // while the stand-in only offers one TLS 1.3 suite.
+    if (json_upstream.empty()) return;
+    struct SuiteRow {
+        std::string suite;
+        double mbs;
+        double client_cpu_ms_per_mib;
+        double proxy_cpu_ms_per_mib;
+    };
+    std::vector<SuiteRow> suite_rows;
+    for (const char *suite : {"TLS_AES_128_GCM_SHA256", "TLS_AES_256_GCM_SHA384", "TLS_CHACHA20_POLY1305_SHA256"}) {
+        TlsProxy proxy(*identity, json_upstream, "http/1.1", suite);
+        if (!proxy.Start()) return;
+        auto client = MakeJsonClient(
+            gc::Options{}
+                .set<gcs::RestEndpointOption>("https://127.0.0.1:" + std::to_string(proxy.Port()))
+                .set<gc::CARootsFilePathOption>(identity->certificate_file)
+                .set<gc::UnifiedCredentialsOption>(gc::MakeInsecureCredentials()));
+        std::cout << "\nJSON Client\n==== Sequential read over " << suite << " ====\n";
+        std::vector<int64_t> durations;
+        std::size_t bytes = 0;
+        auto cpu_start = ProcessCpuTimeMs();
+        auto before = proxy.Snapshot();
+        for (int i = 1; i <= num_iterations; ++i) {
+            auto result = SequentialReadBenchmark(client, bucket, object_name);
+            std::cout << "[" << GetTimestamp() << "] Iteration " << i << ": ";
+            if (result.duration_ms != kErrorDuration) {
+                std::cout << result.bytes_read / kMiB << " MB in " << result.duration_ms << " ms\n";
+                durations.push_back(result.duration_ms);
+                bytes += result.bytes_read;
+            } else {
+                std::cout << "Failed.\n";
+            }
+        }
+        auto proxy_cpu_ms = proxy.Snapshot().cpu_ms - before.cpu_ms;
+        auto client_cpu_ms = ProcessCpuTimeMs() - cpu_start - proxy_cpu_ms;
+        double mib = std::max(bytes / static_cast<double>(kMiB), 1e-9);
+        auto elapsed_ms = std::accumulate(durations.begin(), durations.end(), int64_t{0});
+        suite_rows.push_back({suite, elapsed_ms > 0 ? 1000.0 * mib / elapsed_ms : 0.0, client_cpu_ms / mib,
+                              proxy_cpu_ms / mib});
+    }
+    std::cout << "\n==== TLS 1.3 Suite Cost (JSON sequential reads) ====\n";
+    std::cout << std::left << std::setw(32) << "Suite" << std::setw(10) << "MB/s" << std::setw(20)
+              << "Client CPU ms/MiB" << "Proxy CPU ms/MiB\n";
+    for (const auto &row : suite_rows) {
+        std::cout << std::setw(32) << row.suite << std::setw(10) << row.mbs << std::setw(20)
+                  << row.client_cpu_ms_per_mib << row.proxy_cpu_ms_per_mib << "\n";
+    }
+    std::cout << std::right;
+}
+
+void RunAutotune(const std::string &bucket, const std::string &object_name, const BenchmarkFlags &flags) {
+    constexpr std::size_t kMinTrialReads = 32;  // below that p99 is just the maximum
+    constexpr std::size_t kTrialsShown = 20;
+
+    auto client_name = GetFlag(flags, "tune-client", "json");
+    if (client_name != "json" && client_name != "grpc") {
+        std::cerr << "Error: --tune-client must be json or grpc\n";
+        return;
+    }
+    TuningSpace space;
+    space.read_sizes = GetSizeListFlag(flags, "tune-read-sizes", "64KiB,256KiB,1MiB,4MiB,16MiB");
+    space.buffer_sizes =
+        GetSizeListFlag(flags, "tune-buffer-sizes", client_name == "json" ? "256KiB,1MiB,4MiB" : "0,1MiB,8MiB");
+    for (const auto &value : SplitList(GetFlag(flags, "tune-concurrency", "1,2,4,8,16,32,64"))) {
+        space.concurrency.push_back(std::max(std::stoi(value), 1));
+    }
+    auto strategy = GetFlag(flags, "tune-strategy", "halving");
+    auto budget_bytes = ParseSize(GetFlag(flags, "tune-budget", "64MiB"));
+    int eta = std::stoi(GetFlag(flags, "tune-eta", "3"));
+    double slo_p99_ms = std::stod(GetFlag(flags, "slo-p99-ms", "1000"));
+    if (strategy != "halving" && strategy != "hill") {
+        std::cerr << "Error: --tune-strategy must be halving or hill\n";
+        return;
+    }
+    if (space.read_sizes.empty() || space.buffer_sizes.empty() || space.concurrency.empty()) {
+        std::cerr << "Error: --tune-read-sizes, --tune-buffer-sizes and --tune-concurrency must not be empty\n";
+        return;
+    }
+
+    // One client per buffer size; the JSON pool holds a connection per reader
+    // so higher concurrency is not charged for reconnecting.
+    int max_concurrency = *std::max_element(space.concurrency.begin(), space.concurrency.end());
+    std::map<std::size_t, gcs::Client> clients;
+    auto client_for = [&](std::size_t buffer_size) -> gcs::Client & {
+        auto it = clients.find(buffer_size);
+        if (it != clients.end()) return it->second;
+        if (client_name == "grpc") {
+            // BDP probing would resize the window from the first reads on, so
+            // a tuned window is only held fixed with the probe off.
+            GrpcTransportConfig config{buffer_size, buffer_size == 0 ? "" : "off", 0};
+            return clients.emplace(buffer_size, MakeTunedGrpcClient(config)).first->second;
+        }
+        auto options = gc::Options{}.set<gcs::ConnectionPoolSizeOption>(static_cast<std::size_t>(max_concurrency));
+        if (buffer_size != 0) options.set<gcs::DownloadBufferSizeOption>(buffer_size);
+        return clients.emplace(buffer_size, MakeJsonClient(options)).first->second;
+    };
+
+    auto metadata = client_for(space.buffer_sizes.front()).GetObjectMetadata(bucket, object_name);
+    if (!metadata) {
+        std::cerr << "Error getting metadata for " << bucket << "/" << object_name << ": " << metadata.status() << "\n";
+        return;
+    }
+    std::size_t object_size = metadata->size();
+    space.read_sizes.erase(std::remove_if(space.read_sizes.begin(), space.read_sizes.end(),
+                                          [&](std::size_t size) { return size == 0 || size > object_size; }),
+                           space.read_sizes.end());
+    if (space.read_sizes.empty()) {
+        std::cerr << "Error: every --tune-read-sizes value exceeds the object size (" << object_size << " bytes)\n";
+        return;
+    }
+
+    std::mt19937_64 gen(std::random_device{}());
+    auto run = [&](const TuningConfig &config, std::size_t budget) {
+        TuningTrial trial;
+        trial.config = config;
+        auto &client = client_for(config.buffer_size);
+        RangeReader read_range = [&](std::size_t offset, std::size_t length, char *buffer, std::size_t &bytes_read) {
+            return ReadRangeInto(client, bucket, object_name, offset, length, buffer, bytes_read);
+        };
+        auto reads = std::max({budget / config.read_size, kMinTrialReads,
+                               4 * static_cast<std::size_t>(config.concurrency)});
+        std::uniform_int_distribution<std::size_t> offset(0, object_size - config.read_size);
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        for (std::size_t i = 0; i < reads; ++i) {
+            ranges.emplace_back(offset(gen), config.read_size);
+        }
+
+        // One read per reader first, so the trial measures warm connections.
+        std::vector<double> latencies;
+        std::vector<std::pair<std::size_t, std::size_t>> warmup(ranges.begin(), ranges.begin() + config.concurrency);
+        RunRangeReads(warmup, config.concurrency, read_range, latencies);
+        latencies.clear();
+
+        auto start_time = BenchmarkClock::now();
+        auto result = RunRangeReads(ranges, config.concurrency, read_range, latencies);
+        auto seconds = std::chrono::duration<double>(BenchmarkClock::now() - start_time).count();
+        std::cout << "[" << GetTimestamp() << "] " << config.Label() << ": ";
+        if (result.duration_ms == kErrorDuration) {
+            trial.failed = true;
+            std::cout << "Failed.\n";
+            return trial;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        trial.reads = latencies.size();
+        trial.mbs = seconds > 0 ? result.bytes_read / static_cast<double>(kMiB) / seconds : 0.0;
+        trial.p50_ms = Percentile(latencies, 0.5);
+        trial.p99_ms = Percentile(latencies, 0.99);
+        std::cout << trial.mbs << " MB/s, p50 " << trial.p50_ms << " ms, p99 " << trial.p99_ms << " ms ("
+                  << trial.reads << " reads)" << (MeetsSlo(trial, slo_p99_ms) ? "" : ", misses SLO") << "\n";
+        return trial;
+    };
+
+    std::cout << "\n==== Autotuning " << client_name << " client reads of " << object_name << " ("
+              << FormatSize(object_size) << "), " << strategy << " search, p99 SLO " << slo_p99_ms << " ms ====\n";
+    auto trials = strategy == "hill" ? HillClimb(space, run, budget_bytes, eta, slo_p99_ms)
+                                     : SuccessiveHalving(space, run, budget_bytes, eta, slo_p99_ms);
+    if (trials.empty()) return;
+    const auto best = trials.back();
+
+    // The most precise (last) measurement of every configuration tried.
+    std::map<std::string, TuningTrial> latest;
+    for (const auto &trial : trials) {
+        latest[trial.config.Label()] = trial;
+    }
+    std::vector<TuningTrial> ranked;
+    for (const auto &entry : latest) {
+        ranked.push_back(entry.second);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [&](const TuningTrial &a, const TuningTrial &b) { return BetterTrial(a, b, slo_p99_ms); });
+
+    std::cout << "\n==== Autotune Ranking (" << trials.size() << " trials, " << ranked.size()
+              << " configurations) ====\n";
+    std::cout << std::left << std::setw(44) << "Configuration" << std::setw(12) << "MB/s" << std::setw(12) << "P50 ms"
+              << std::setw(12) << "P99 ms" << std::setw(10) << "Reads" << "SLO\n";
+    for (std::size_t i = 0; i < ranked.size() && i < kTrialsShown; ++i) {
+        const auto &trial = ranked[i];
+        std::cout << std::setw(44) << trial.config.Label() << std::setw(12) << trial.mbs << std::setw(12)
+                  << trial.p50_ms << std::setw(12) << trial.p99_ms << std::setw(10) << trial.reads
+                  << (trial.failed ? "failed" : MeetsSlo(trial, slo_p99_ms) ? "met" : "missed") << "\n";
+    }
+    if (ranked.size() > kTrialsShown) std::cout << "(" << ranked.size() - kTrialsShown << " more)\n";
+    std::cout << std::right;
+
+    std::cout << "\n==== Recommended Configuration ====\n";
+    if (!MeetsSlo(best, slo_p99_ms)) {
+        std::cout << "No configuration met the p99 SLO of " << slo_p99_ms << " ms; this one came closest.\n";
+    }
+    std::cout << "Client:       " << client_name << "\n";
+    std::cout << "Read size:    " << FormatSize(best.config.read_size) << "\n";
+    std::string buffer_meaning = " (DownloadBufferSizeOption)";
+    if (client_name == "grpc") {
+        buffer_meaning = best.config.buffer_size == 0 ? " (HTTP/2 stream window, BDP probing on)"
+                                                      : " (HTTP/2 stream window, BDP probing off)";
+    }
+    std::cout << "Buffer size:  " << (best.config.buffer_size == 0 ? std::string("default")
+                                                                    : FormatSize(best.config.buffer_size))
+              << buffer_meaning << "\n";
+    std::cout << "Concurrency:  " << best.config.concurrency << "\n";
+    std::cout << "Throughput:   " << best.mbs << " MB/s, p50 " << best.p50_ms << " ms, p99 " << best.p99_ms
+              << " ms over " << best.reads << " reads\n";
+
+    auto output = GetFlag(flags, "tune-output", "");
+    if (!output.empty() &&
+        AppendTuningResult(output, GetFlag(flags, "tune-label", ""), client_name, object_name, object_size,
+                           slo_p99_ms, best)) {
+        std::cout << "Appended to " << output << "\n";
+    }
+}
+
+}  // namespace gcsbench
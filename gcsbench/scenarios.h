@@ -0,0 +1,162 @@
+#ifndef GCSBENCH_SCENARIOS_H
+#define GCSBENCH_SCENARIOS_H
+
+#include "gcsbench/executors.h"
+#include "gcsbench/flags.h"
+
+#include <string>
+
+namespace gcsbench {
+
+// Fills `instrumentation` from the --timeline-*, --memory and --profile*
+// flags. Returns false (after logging) if a value is invalid.
+bool ParsePhaseInstrumentation(const BenchmarkFlags &flags, PhaseInstrumentation &instrumentation);
+
+// The default run: sequential reads, then random reads of 4MiB, 2MiB, 1MiB
+// and 100KiB with `concurrency` threads, each with the gRPC and JSON clients.
+void RunDefaultBenchmark(int num_iterations,
+                         const std::string &bucket,
+                         const std::string &object_name,
+                         int concurrency,
+                         const PhaseInstrumentation &instrumentation);
+
+// Runs the sequential and (concurrent) random workloads for every combination
+// of JSON transport settings, then prints one summary row per configuration
+// next to the default gRPC client.
+void RunJsonTuningSweep(int num_iterations,
+                        const std::string &bucket,
+                        const std::string &object_name,
+                        const BenchmarkFlags &flags);
+
+// Runs the sequential and random workloads on a gRPC client for every
+// combination of HTTP/2 flow-control channel arguments (initial stream
+// window, BDP probing, max receive message size) and reports throughput per
+// stream, most telling over a shaped long-haul link (scripts/netem_sweep.sh).
+void RunGrpcFlowControlSweep(int num_iterations,
+                             const std::string &bucket,
+                             const std::string &object_name,
+                             const BenchmarkFlags &flags);
+
+// Compares sequential reads with each combination of CRC32C/MD5 validation
+// for both clients. The extra CPU over the "none" mode is attributed to
+// hashing; the read data is then reused for the CRC32C kernel benchmark.
+void RunHashingBenchmark(int num_iterations,
+                         const std::string &bucket,
+                         const std::string &object_name,
+                         const BenchmarkFlags &flags);
+
+void RunTraceReplay(int num_iterations,
+                    const std::string &bucket,
+                    const std::string &object_name,
+                    const BenchmarkFlags &flags);
+
+// Sweeps target request rates open-loop for both clients and reports the
+// knee: the first rate where the achieved rate falls behind the target or
+// P99 latency grows past --knee-factor times its value at the lowest rate.
+void RunOpenLoopBenchmark(const std::string &bucket,
+                          const std::string &object_name,
+                          const BenchmarkFlags &flags);
+
+// Runs gRPC and JSON iterations in pairs, in a random order within each pair,
+// so drift in network conditions affects both clients alike. After
+// `min_iterations` pairs it keeps going until both means have a relative 95%
+// CI half-width below --ci-target, or --max-iterations is reached.
+void RunInterleavedComparison(int min_iterations,
+                              const std::string &bucket,
+                              const std::string &object_name,
+                              const BenchmarkFlags &flags);
+
+// Reads a random subset of columns from every row group into one
+// pre-allocated buffer per column, comparing one request per chunk through a
+// scratch buffer (plus a copy) against ScatterRead with and without gap
+// coalescing. The column buffers are checksummed to confirm all approaches
+// deliver the same bytes.
+void RunColumnarReadBenchmark(int num_iterations,
+                              const std::string &bucket,
+                              const std::string &object_name,
+                              const BenchmarkFlags &flags);
+
+// Compares three ways of reading the same random ranges over gRPC: one
+// ReadObject stream per range (sync client), one async ReadObjectRange RPC
+// per range, and all ranges multiplexed over a single bidi stream opened with
+// AsyncClient::Open. Opening the descriptor is part of each iteration.
+void RunMultiRangeBenchmark(int num_iterations,
+                            const std::string &bucket,
+                            const std::string &object_name,
+                            const BenchmarkFlags &flags);
+
+// Measures end-to-end decoded throughput for both clients. gzip objects
+// stored with Content-Encoding: gzip are also read with decompressive
+// transcoding on the JSON API (the gRPC API always returns stored bytes), so
+// service-side and client-side decode can be compared.
+void RunDecompressionBenchmark(int num_iterations,
+                               const std::string &bucket,
+                               const std::string &object_name,
+                               const BenchmarkFlags &flags);
+
+// Sweeps ring buffer count and size with a consumer that either burns
+// --cost-ns-per-kib of CPU or computes CRC32C over the data, reporting how
+// much of the download and processing time overlapped.
+void RunPipelineBenchmark(int num_iterations,
+                          const std::string &bucket,
+                          const std::string &object_name,
+                          const BenchmarkFlags &flags);
+
+// Runs concurrent random reads at each concurrency level for both clients,
+// sampling memory for the whole level, and prints memory against concurrency.
+void RunMemoryBenchmark(int num_iterations,
+                        const std::string &bucket,
+                        const std::string &object_name,
+                        const BenchmarkFlags &flags);
+
+// Reads the whole object with the stock gRPC client and with the raw stub
+// driver in each message mode, reporting throughput, CPU per GiB and C++
+// allocations per MB. The zero-copy variants consume the bytes inside the
+// response messages; "reuse + copy" adds the copy into a caller buffer that
+// ObjectReadStream always performs.
+void RunRawGrpcBenchmark(int num_iterations,
+                         const std::string &bucket,
+                         const std::string &object_name,
+                         const BenchmarkFlags &flags);
+
+// Enables the client library's OpenTelemetry tracing for both clients at
+// several sampling ratios ("off" leaves tracing disabled), records the spans
+// in memory (and optionally to a JSON lines file), breaks read time down by
+// library component and reports the throughput, latency and CPU cost of each
+// ratio relative to running without tracing.
+void RunTracingBenchmark(int num_iterations,
+                         const std::string &bucket,
+                         const std::string &object_name,
+                         const BenchmarkFlags &flags);
+
+// Runs the sequential and random workloads of the default mode on each
+// backend in --backends (json, grpc, raw-curl, raw-grpc, uring, s3, http2,
+// file, mmap), so the client libraries can be compared with raw protocol and
+// local-disk baselines on the same harness. Also reports process CPU per
+// random read and each backend's transport counters.
+void RunBackendComparison(int num_iterations,
+                          const std::string &bucket,
+                          const std::string &object_name,
+                          const BenchmarkFlags &flags);
+
+// Measures what TLS costs the clients against a local TLS-terminating
+// stand-in (TlsProxy) for the emulator: full and resumed TLS 1.2/1.3
+// handshake latency and client/server CPU, connection setup and resumption
+// hit rate of the JSON and (with --tls-grpc-upstream) gRPC clients with a new
+// vs a reused client, AEAD record cost per cipher on one core, and JSON read
+// throughput and CPU per MiB with each TLS 1.3 suite forced.
+void RunTlsBenchmark(int num_iterations,
+                     const std::string &bucket,
+                     const std::string &object_name,
+                     const BenchmarkFlags &flags);
+
+// Searches read size, client buffer size and concurrency for the `--tune-*`
+// client (successive halving over the grid, or hill climbing) to maximize
+// random-read throughput while the p99 read latency stays within
+// --slo-p99-ms, then prints the recommended configuration and optionally
+// appends it as a JSON line to --tune-output.
+void RunAutotune(const std::string &bucket, const std::string &object_name, const BenchmarkFlags &flags);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_SCENARIOS_H
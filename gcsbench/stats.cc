@@ -0,0 +1,144 @@
+#include "gcsbench/stats.h"
+
+#include "gcsbench/common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <utility>
+
+namespace gcsbench {
+
+double Percentile(const std::vector<double> &sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    double rank = q * (sorted.size() - 1);
+    auto lower = static_cast<size_t>(std::floor(rank));
+    auto upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (rank - lower) * (sorted[upper] - sorted[lower]);
+}
+
+double Mean(const std::vector<double> &sample) {
+    return sample.empty() ? 0.0 : std::accumulate(sample.begin(), sample.end(), 0.0) / sample.size();
+}
+
+namespace {
+
+// Percentile bootstrap interval for the mean. Seeded so that reruns over the
+// same samples report the same interval.
+ConfidenceInterval BootstrapMeanCI(const std::vector<double> &sample,
+                                   double confidence = 0.95,
+                                   int resamples = 2000) {
+    ConfidenceInterval ci;
+    if (sample.empty()) return ci;
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<std::size_t> pick(0, sample.size() - 1);
+    std::vector<double> means(resamples);
+    for (auto &mean : means) {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < sample.size(); ++i) {
+            sum += sample[pick(gen)];
+        }
+        mean = sum / sample.size();
+    }
+    std::sort(means.begin(), means.end());
+    ci.low = Percentile(means, (1.0 - confidence) / 2);
+    ci.high = Percentile(means, 1.0 - (1.0 - confidence) / 2);
+    return ci;
+}
+
+}  // namespace
+
+MannWhitneyResult MannWhitneyU(const std::vector<double> &a, const std::vector<double> &b) {
+    MannWhitneyResult result;
+    if (a.empty() || b.empty()) return result;
+
+    std::vector<std::pair<double, int>> pooled;
+    for (auto v : a) pooled.push_back({v, 0});
+    for (auto v : b) pooled.push_back({v, 1});
+    std::sort(pooled.begin(), pooled.end());
+
+    double n1 = a.size(), n2 = b.size(), n = n1 + n2;
+    double rank_sum_a = 0.0;
+    double tie_term = 0.0;
+    for (std::size_t i = 0; i < pooled.size();) {
+        auto j = i;
+        while (j < pooled.size() && pooled[j].first == pooled[i].first) ++j;
+        double ties = j - i;
+        double average_rank = (i + 1 + j) / 2.0;
+        for (auto k = i; k < j; ++k) {
+            if (pooled[k].second == 0) rank_sum_a += average_rank;
+        }
+        tie_term += ties * ties * ties - ties;
+        i = j;
+    }
+
+    result.u = rank_sum_a - n1 * (n1 + 1) / 2;
+    double mean_u = n1 * n2 / 2;
+    double variance = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)));
+    if (variance <= 0) return result;
+    double diff = result.u - mean_u;
+    double corrected = std::max(0.0, std::fabs(diff) - 0.5);
+    result.z = (diff < 0 ? -corrected : corrected) / std::sqrt(variance);
+    result.p_value = std::erfc(std::fabs(result.z) / std::sqrt(2.0));
+    return result;
+}
+
+AggregateStats ComputeAggregateStats(size_t file_size_bytes,
+                                     const std::vector<int64_t> &successful_durations) {
+    AggregateStats stats;
+    stats.successful_iterations = successful_durations.size();
+    if (stats.successful_iterations == 0) {
+        return stats;
+    }
+
+    std::vector<double> sorted_durations(successful_durations.begin(), successful_durations.end());
+    std::sort(sorted_durations.begin(), sorted_durations.end());
+
+    stats.avg_duration_ms = Mean(sorted_durations);
+    double squares = 0.0;
+    for (auto d : sorted_durations) {
+        squares += (d - stats.avg_duration_ms) * (d - stats.avg_duration_ms);
+    }
+    stats.stddev_duration_ms = stats.successful_iterations > 1
+                                   ? std::sqrt(squares / (stats.successful_iterations - 1))
+                                   : 0.0;
+    stats.mean_duration_ci_ms = BootstrapMeanCI(sorted_durations);
+
+    stats.p50_duration_ms = Percentile(sorted_durations, 0.5);
+    stats.p90_duration_ms = Percentile(sorted_durations, 0.9);
+    stats.min_duration_ms = static_cast<int64_t>(sorted_durations.front());
+    stats.max_duration_ms = static_cast<int64_t>(sorted_durations.back());
+
+    double q1 = Percentile(sorted_durations, 0.25);
+    double q3 = Percentile(sorted_durations, 0.75);
+    double low_fence = q1 - 1.5 * (q3 - q1);
+    double high_fence = q3 + 1.5 * (q3 - q1);
+    std::vector<double> inliers;
+    for (auto d : sorted_durations) {
+        if (d < low_fence || d > high_fence) {
+            ++stats.outliers;
+        } else {
+            inliers.push_back(d);
+        }
+    }
+    stats.mean_without_outliers_ms = Mean(inliers);
+
+    double file_size_mb = file_size_bytes / static_cast<double>(kMiB);
+    auto throughput = [&](double duration_ms) {
+        return duration_ms > 0 ? file_size_mb / (duration_ms / 1000.0) : 0.0;
+    };
+    stats.avg_throughput_mbs = throughput(stats.avg_duration_ms);
+    stats.throughput_ci_mbs = {throughput(stats.mean_duration_ci_ms.high), throughput(stats.mean_duration_ci_ms.low)};
+    return stats;
+}
+
+double RelativeCIWidth(const std::vector<int64_t> &durations) {
+    std::vector<double> sample(durations.begin(), durations.end());
+    auto mean = Mean(sample);
+    auto ci = BootstrapMeanCI(sample);
+    return mean > 0 ? (ci.high - ci.low) / 2 / mean : std::numeric_limits<double>::infinity();
+}
+
+}  // namespace gcsbench
@@ -0,0 +1,54 @@
+#ifndef GCSBENCH_STATS_H
+#define GCSBENCH_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gcsbench {
+
+// Percentile of an already sorted sample, linearly interpolating between the
+// two closest ranks.
+double Percentile(const std::vector<double> &sorted, double q);
+
+double Mean(const std::vector<double> &sample);
+
+struct ConfidenceInterval {
+    double low = 0.0;
+    double high = 0.0;
+};
+
+struct MannWhitneyResult {
+    double u = 0.0;        // U statistic of the first sample
+    double z = 0.0;
+    double p_value = 1.0;  // two-sided, normal approximation
+};
+
+// Mann-Whitney U test with average ranks for ties, tie-corrected variance and
+// a continuity correction.
+MannWhitneyResult MannWhitneyU(const std::vector<double> &a, const std::vector<double> &b);
+
+struct AggregateStats {
+    int successful_iterations = 0;
+    double avg_duration_ms = 0.0;
+    double stddev_duration_ms = 0.0;
+    ConfidenceInterval mean_duration_ci_ms;  // 95% bootstrap
+    double p50_duration_ms = 0.0;
+    double p90_duration_ms = 0.0;
+    int64_t min_duration_ms = 0;
+    int64_t max_duration_ms = 0;
+    int outliers = 0;                        // outside Tukey's 1.5 IQR fences
+    double mean_without_outliers_ms = 0.0;
+    double avg_throughput_mbs = 0.0;
+    ConfidenceInterval throughput_ci_mbs;
+};
+
+AggregateStats ComputeAggregateStats(size_t file_size_bytes,
+                                     const std::vector<int64_t> &successful_durations);
+
+// Relative half-width of the bootstrap CI of the mean.
+double RelativeCIWidth(const std::vector<int64_t> &durations);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_STATS_H
@@ -0,0 +1,315 @@
+#include "gcsbench/streaming.h"
+
+#include <zlib.h>
+
+#ifdef GCS_BENCHMARK_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gcsbench {
+
+namespace {
+
+// Fixed set of buffers passed between one producer and one consumer thread.
+// The producer blocks when every buffer is full and the consumer blocks when
+// none is; the time each side spends blocked is accumulated.
+class BufferRing {
+public:
+    struct Slot {
+        std::vector<char> data;
+        std::size_t size = 0;
+        bool last = false;  // no more slots follow
+    };
+
+    BufferRing(std::size_t count, std::size_t buffer_size) : slots_(count) {
+        for (auto &slot : slots_) {
+            slot.data.resize(buffer_size);
+            free_.push_back(&slot);
+        }
+    }
+
+    Slot *AcquireFree() { return Pop(free_, producer_wait_ms_); }
+    void Publish(Slot *slot) { Push(filled_, slot); }
+    Slot *AcquireFilled() { return Pop(filled_, consumer_wait_ms_); }
+    void Release(Slot *slot) { Push(free_, slot); }
+
+    double producer_wait_ms() const { return producer_wait_ms_; }
+    double consumer_wait_ms() const { return consumer_wait_ms_; }
+
+private:
+    Slot *Pop(std::deque<Slot *> &queue, double &wait_ms) {
+        std::unique_lock<std::mutex> lock(mu_);
+        if (queue.empty()) {
+            auto start = BenchmarkClock::now();
+            cv_.wait(lock, [&] { return !queue.empty(); });
+            wait_ms += std::chrono::duration<double, std::milli>(BenchmarkClock::now() - start).count();
+        }
+        auto *slot = queue.front();
+        queue.pop_front();
+        return slot;
+    }
+
+    void Push(std::deque<Slot *> &queue, Slot *slot) {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            queue.push_back(slot);
+        }
+        cv_.notify_all();
+    }
+
+    std::vector<Slot> slots_;
+    std::deque<Slot *> free_;
+    std::deque<Slot *> filled_;
+    std::mutex mu_;
+    std::condition_variable cv_;
+    double producer_wait_ms_ = 0.0;
+    double consumer_wait_ms_ = 0.0;
+};
+
+class PassthroughDecoder : public StreamDecoder {
+public:
+    bool Decode(const char *, std::size_t size, std::size_t &decoded) override {
+        decoded += size;
+        return true;
+    }
+};
+
+// gzip or zlib input (detected from the header), including concatenated
+// gzip members.
+class GzipDecoder : public StreamDecoder {
+public:
+    explicit GzipDecoder(std::size_t output_size) : output_(output_size) {
+        inflateInit2(&stream_, 32 + MAX_WBITS);
+    }
+    ~GzipDecoder() override { inflateEnd(&stream_); }
+
+    bool Decode(const char *data, std::size_t size, std::size_t &decoded) override {
+        stream_.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        stream_.avail_in = static_cast<uInt>(size);
+        // Keep going while input remains or the output buffer was filled,
+        // since inflate may hold back output it had no room for.
+        bool output_full = true;
+        while (stream_.avail_in > 0 || output_full) {
+            stream_.next_out = reinterpret_cast<Bytef *>(output_.data());
+            stream_.avail_out = static_cast<uInt>(output_.size());
+            auto rc = inflate(&stream_, Z_NO_FLUSH);
+            decoded += output_.size() - stream_.avail_out;
+            output_full = stream_.avail_out == 0;
+            if (rc == Z_STREAM_END) {
+                inflateReset(&stream_);
+            } else if (rc == Z_BUF_ERROR) {
+                break;
+            } else if (rc != Z_OK) {
+                std::cerr << "Error inflating stream: " << (stream_.msg ? stream_.msg : "unknown") << "\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    z_stream stream_{};
+    std::vector<char> output_;
+};
+
+#ifdef GCS_BENCHMARK_HAVE_ZSTD
+class ZstdDecoder : public StreamDecoder {
+public:
+    explicit ZstdDecoder(std::size_t output_size) : stream_(ZSTD_createDStream()), output_(output_size) {
+        ZSTD_initDStream(stream_);
+    }
+    ~ZstdDecoder() override { ZSTD_freeDStream(stream_); }
+
+    bool Decode(const char *data, std::size_t size, std::size_t &decoded) override {
+        ZSTD_inBuffer in{data, size, 0};
+        bool output_full = true;
+        while (in.pos < in.size || output_full) {
+            ZSTD_outBuffer out{output_.data(), output_.size(), 0};
+            auto rc = ZSTD_decompressStream(stream_, &out, &in);
+            if (ZSTD_isError(rc)) {
+                std::cerr << "Error decompressing zstd stream: " << ZSTD_getErrorName(rc) << "\n";
+                return false;
+            }
+            decoded += out.pos;
+            output_full = out.pos == out.size;
+        }
+        return true;
+    }
+
+private:
+    ZSTD_DStream *stream_;
+    std::vector<char> output_;
+};
+#endif
+
+}  // namespace
+
+std::unique_ptr<StreamDecoder> MakeDecoder(const std::string &codec, std::size_t output_size) {
+    if (codec == "gzip") return std::make_unique<GzipDecoder>(output_size);
+#ifdef GCS_BENCHMARK_HAVE_ZSTD
+    if (codec == "zstd") return std::make_unique<ZstdDecoder>(output_size);
+#endif
+    if (codec == "none") return std::make_unique<PassthroughDecoder>();
+    return nullptr;
+}
+
+DecodeResult DecompressingReadBenchmark(gcs::Client &client,
+                                        const std::string &bucket,
+                                        const std::string &object_name,
+                                        const std::string &codec,
+                                        bool accept_gzip,
+                                        bool pipelined,
+                                        std::size_t chunk_size,
+                                        std::size_t buffers) {
+    DecodeResult result;
+    auto decoder = MakeDecoder(codec, chunk_size);
+    if (!decoder) {
+        std::cerr << "Error: unsupported codec " << codec << "\n";
+        return result;
+    }
+
+    auto cpu_start = ProcessCpuTimeMs();
+    auto start_time = BenchmarkClock::now();
+    auto stream = accept_gzip ? client.ReadObject(bucket, object_name, gcs::AcceptEncodingGzip())
+                              : client.ReadObject(bucket, object_name);
+    if (!stream) {
+        std::cerr << "Error opening object for decompressing read: " << stream.status() << "\n";
+        return result;
+    }
+
+    bool ok = true;
+    if (!pipelined) {
+        std::vector<char> buffer(chunk_size);
+        auto decoder_cpu_start = ThreadCpuTimeMs();
+        double read_cpu_ms = 0.0;
+        while (ok) {
+            auto read_start = ThreadCpuTimeMs();
+            stream.read(buffer.data(), buffer.size());
+            read_cpu_ms += ThreadCpuTimeMs() - read_start;
+            auto n = static_cast<std::size_t>(stream.gcount());
+            result.bytes_read += n;
+            ok = decoder->Decode(buffer.data(), n, result.bytes_decoded);
+            if (!stream) break;
+        }
+        result.decoder_cpu_ms = ThreadCpuTimeMs() - decoder_cpu_start - read_cpu_ms;
+    } else {
+        BufferRing ring(std::max<std::size_t>(buffers, 1), chunk_size);
+        std::thread decode_thread([&] {
+            auto decoder_cpu_start = ThreadCpuTimeMs();
+            bool decode_ok = true;
+            for (;;) {
+                auto *slot = ring.AcquireFilled();
+                bool last = slot->last;
+                if (decode_ok) decode_ok = decoder->Decode(slot->data.data(), slot->size, result.bytes_decoded);
+                ring.Release(slot);
+                if (last) break;
+            }
+            result.decoder_cpu_ms = ThreadCpuTimeMs() - decoder_cpu_start;
+            if (!decode_ok) ok = false;
+        });
+        for (;;) {
+            auto *slot = ring.AcquireFree();
+            stream.read(slot->data.data(), slot->data.size());
+            slot->size = stream.gcount();
+            slot->last = !stream;
+            result.bytes_read += slot->size;
+            ring.Publish(slot);
+            if (slot->last) break;
+        }
+        decode_thread.join();
+        result.reader_wait_ms = ring.producer_wait_ms();
+        result.decoder_wait_ms = ring.consumer_wait_ms();
+    }
+    g_progress.bytes.fetch_add(result.bytes_read, std::memory_order_relaxed);
+    g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+
+    if (!stream.eof()) {
+        std::cerr << "Error during decompressing read: " << stream.status() << "\n";
+        return result;
+    }
+    if (!ok) return result;
+    result.duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(BenchmarkClock::now() - start_time).count();
+    result.process_cpu_ms = ProcessCpuTimeMs() - cpu_start;
+    return result;
+}
+
+std::string DetectCodec(const gcs::ObjectMetadata &metadata, const std::string &object_name) {
+    auto ends_with = [&](const std::string &suffix) {
+        return object_name.size() >= suffix.size() &&
+               object_name.compare(object_name.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (metadata.content_encoding() == "gzip" || ends_with(".gz")) return "gzip";
+    if (metadata.content_encoding() == "zstd" || ends_with(".zst")) return "zstd";
+    return "none";
+}
+
+PipelineResult PipelinedReadBenchmark(gcs::Client &client,
+                                      const std::string &bucket,
+                                      const std::string &object_name,
+                                      std::size_t buffer_count,
+                                      std::size_t buffer_size,
+                                      const std::function<void(const char *, std::size_t)> &consume) {
+    PipelineResult result;
+    auto start_time = BenchmarkClock::now();
+    auto stream = client.ReadObject(bucket, object_name);
+    if (!stream) {
+        std::cerr << "Error opening object for pipelined read: " << stream.status() << "\n";
+        return result;
+    }
+
+    BufferRing ring(buffer_count, buffer_size);
+    std::thread consumer([&] {
+        for (;;) {
+            auto *slot = ring.AcquireFilled();
+            bool last = slot->last;
+            auto compute_start = BenchmarkClock::now();
+            consume(slot->data.data(), slot->size);
+            result.compute_ms += std::chrono::duration<double, std::milli>(BenchmarkClock::now() - compute_start).count();
+            ring.Release(slot);
+            if (last) break;
+        }
+    });
+    for (;;) {
+        auto *slot = ring.AcquireFree();
+        auto read_start = BenchmarkClock::now();
+        stream.read(slot->data.data(), slot->data.size());
+        result.network_ms += std::chrono::duration<double, std::milli>(BenchmarkClock::now() - read_start).count();
+        slot->size = stream.gcount();
+        slot->last = !stream;
+        result.bytes_read += slot->size;
+        g_progress.bytes.fetch_add(slot->size, std::memory_order_relaxed);
+        ring.Publish(slot);
+        if (slot->last) break;
+    }
+    consumer.join();
+    g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+    result.producer_wait_ms = ring.producer_wait_ms();
+    result.consumer_wait_ms = ring.consumer_wait_ms();
+
+    if (!stream.eof()) {
+        std::cerr << "Error during pipelined read: " << stream.status() << "\n";
+        return result;
+    }
+    result.duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(BenchmarkClock::now() - start_time).count();
+    return result;
+}
+
+void SpinConsume(const char *data, std::size_t size, double ns_per_kib) {
+    volatile char sink = 0;
+    for (std::size_t i = 0; i < size; i += 64) sink = sink + data[i];
+    auto deadline = BenchmarkClock::now() + std::chrono::nanoseconds(static_cast<int64_t>(ns_per_kib * size / kKiB));
+    while (BenchmarkClock::now() < deadline) {
+    }
+}
+
+}  // namespace gcsbench
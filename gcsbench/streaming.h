@@ -0,0 +1,80 @@
+#ifndef GCSBENCH_STREAMING_H
+#define GCSBENCH_STREAMING_H
+
+#include "gcsbench/common.h"
+
+#include "google/cloud/storage/client.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace gcsbench {
+
+// Incremental decoder fed with consecutive pieces of a compressed stream.
+class StreamDecoder {
+public:
+    virtual ~StreamDecoder() = default;
+    // Decodes `size` input bytes, adding the number of output bytes to `decoded`.
+    virtual bool Decode(const char *data, std::size_t size, std::size_t &decoded) = 0;
+};
+
+std::unique_ptr<StreamDecoder> MakeDecoder(const std::string &codec, std::size_t output_size);
+
+struct DecodeResult {
+    int64_t duration_ms = kErrorDuration;
+    std::size_t bytes_read = 0;     // as received from the service
+    std::size_t bytes_decoded = 0;
+    double process_cpu_ms = 0.0;
+    double decoder_cpu_ms = 0.0;    // CPU of the thread running the decoder
+    double reader_wait_ms = 0.0;    // network thread blocked on a full ring
+    double decoder_wait_ms = 0.0;   // decoder blocked on an empty ring
+};
+
+// Downloads the object and decodes it with `codec`. With `pipelined` the
+// decoder runs on its own thread, overlapped with the download through a ring
+// of `buffers` chunks; otherwise each chunk is decoded before the next read.
+// `accept_gzip` asks the service for the stored (compressed) bytes instead of
+// decompressive transcoding.
+DecodeResult DecompressingReadBenchmark(gcs::Client &client,
+                                        const std::string &bucket,
+                                        const std::string &object_name,
+                                        const std::string &codec,
+                                        bool accept_gzip,
+                                        bool pipelined,
+                                        std::size_t chunk_size,
+                                        std::size_t buffers);
+
+// Picks the codec from the object's Content-Encoding, falling back to its
+// name suffix.
+std::string DetectCodec(const gcs::ObjectMetadata &metadata, const std::string &object_name);
+
+struct PipelineResult {
+    int64_t duration_ms = kErrorDuration;
+    std::size_t bytes_read = 0;
+    double network_ms = 0.0;        // producer time inside stream reads
+    double compute_ms = 0.0;        // consumer time inside `consume`
+    double producer_wait_ms = 0.0;  // network idle, every buffer full
+    double consumer_wait_ms = 0.0;  // consumer idle, no buffer ready
+};
+
+// Downloads the object through a ring of `buffer_count` buffers of
+// `buffer_size` bytes, with `consume` run on a separate thread for every
+// filled buffer. One buffer serializes download and processing; more let
+// them overlap.
+PipelineResult PipelinedReadBenchmark(gcs::Client &client,
+                                      const std::string &bucket,
+                                      const std::string &object_name,
+                                      std::size_t buffer_count,
+                                      std::size_t buffer_size,
+                                      const std::function<void(const char *, std::size_t)> &consume);
+
+// Busy-waits for `ns_per_kib` per KiB of input, reading every cache line so
+// the data is actually touched, like a parser would.
+void SpinConsume(const char *data, std::size_t size, double ns_per_kib);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_STREAMING_H
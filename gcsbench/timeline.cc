@@ -0,0 +1,64 @@
+#include "gcsbench/timeline.h"
+
+namespace gcsbench {
+
+SteadyState DetectSteadyState(const std::vector<TimelineSample> &samples) {
+    SteadyState state;
+    if (samples.empty()) return state;
+
+    std::vector<double> rates;
+    rates.reserve(samples.size());
+    double previous_ms = 0.0;
+    for (const auto &sample : samples) {
+        double interval_s = std::max(sample.elapsed_ms - previous_ms, 1e-3) / 1000.0;
+        rates.push_back(sample.bytes / static_cast<double>(kMiB) / interval_s);
+        previous_ms = sample.elapsed_ms;
+    }
+
+    std::size_t trim = samples.size() / 10;
+    std::vector<double> middle(rates.begin() + trim, rates.end() - trim);
+    std::sort(middle.begin(), middle.end());
+    double reference = middle[middle.size() / 2];
+    state.last = samples.size() - 1;
+    if (reference <= 0) return state;
+
+    while (state.first < state.last && rates[state.first] < 0.8 * reference) ++state.first;
+    while (state.last > state.first && rates[state.last] < 0.8 * reference) --state.last;
+
+    uint64_t bytes = 0;
+    for (auto i = state.first; i <= state.last; ++i) {
+        bytes += samples[i].bytes;
+        if (rates[i] < 0.1 * reference) {
+            ++state.stalls;
+            state.stall_ms += samples[i].elapsed_ms - (i == 0 ? 0.0 : samples[i - 1].elapsed_ms);
+        }
+    }
+    double window_start_ms = state.first == 0 ? 0.0 : samples[state.first - 1].elapsed_ms;
+    double window_ms = samples[state.last].elapsed_ms - window_start_ms;
+    state.throughput_mbs = window_ms > 0 ? bytes / static_cast<double>(kMiB) / (window_ms / 1000.0) : 0.0;
+    return state;
+}
+
+void TimelineRecorder::Sample() {
+    auto start = BenchmarkClock::now();
+    auto last_bytes = g_progress.bytes.load();
+    auto last_requests = g_progress.requests.load();
+    auto next = start;
+    bool stopping = false;
+    while (!stopping) {
+        next += interval_;
+        while (!stop_ && BenchmarkClock::now() < next) {
+            std::this_thread::sleep_for(std::min<BenchmarkClock::duration>(next - BenchmarkClock::now(),
+                                                                           std::chrono::milliseconds(5)));
+        }
+        stopping = stop_;
+        auto bytes = g_progress.bytes.load();
+        auto requests = g_progress.requests.load();
+        auto elapsed = std::chrono::duration<double, std::milli>(BenchmarkClock::now() - start).count();
+        samples_.push_back({elapsed, bytes - last_bytes, requests - last_requests});
+        last_bytes = bytes;
+        last_requests = requests;
+    }
+}
+
+}  // namespace gcsbench
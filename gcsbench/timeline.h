@@ -0,0 +1,68 @@
+#ifndef GCSBENCH_TIMELINE_H
+#define GCSBENCH_TIMELINE_H
+
+#include "gcsbench/common.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace gcsbench {
+
+struct TimelineSample {
+    double elapsed_ms;
+    uint64_t bytes;     // completed during this interval
+    uint64_t requests;  // completed during this interval
+};
+
+// Samples g_progress on a background thread every `interval` between Start()
+// and Stop(), turning the cumulative counters into per-interval deltas.
+class TimelineRecorder {
+public:
+    explicit TimelineRecorder(std::chrono::milliseconds interval) : interval_(interval) {}
+    ~TimelineRecorder() { Stop(); }
+
+    void Start() {
+        samples_.clear();
+        stop_ = false;
+        thread_ = std::thread([this] { Sample(); });
+    }
+
+    std::vector<TimelineSample> Stop() {
+        if (thread_.joinable()) {
+            stop_ = true;
+            thread_.join();
+        }
+        return samples_;
+    }
+
+private:
+    void Sample();
+
+    std::chrono::milliseconds interval_;
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+    std::vector<TimelineSample> samples_;
+};
+
+struct SteadyState {
+    std::size_t first = 0;  // first sample in the window
+    std::size_t last = 0;   // last sample in the window (inclusive)
+    double throughput_mbs = 0.0;
+    int stalls = 0;         // intervals inside the window with almost no progress
+    double stall_ms = 0.0;
+};
+
+// The reference rate is the median interval rate, ignoring the outer 10% of
+// samples on each side. The steady-state window spans the first through the
+// last interval reaching 80% of it, which trims slow-start ramp-up and the
+// partial final interval; intervals inside it below 10% count as stalls.
+SteadyState DetectSteadyState(const std::vector<TimelineSample> &samples);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_TIMELINE_H
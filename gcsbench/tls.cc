@@ -0,0 +1,504 @@
+#include "gcsbench/tls.h"
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509v3.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace gcsbench {
+
+namespace {
+
+constexpr std::size_t kPumpBufferSize = 64 * kKiB;
+constexpr int kTicketWaitMs = 1000;
+constexpr std::size_t kAeadTagSize = 16;
+constexpr std::size_t kAeadNonceSize = 12;
+
+std::string OpenSslError() {
+    unsigned long code = ERR_get_error();
+    if (code == 0) return std::strerror(errno);
+    char message[256];
+    ERR_error_string_n(code, message, sizeof(message));
+    ERR_clear_error();
+    return message;
+}
+
+bool AddExtension(X509 *certificate, int nid, const char *value) {
+    X509V3_CTX ctx;
+    X509V3_set_ctx_nodb(&ctx);
+    X509V3_set_ctx(&ctx, certificate, certificate, nullptr, nullptr, 0);
+    X509_EXTENSION *extension = X509V3_EXT_conf_nid(nullptr, &ctx, nid, value);
+    if (extension == nullptr) return false;
+    bool ok = X509_add_ext(certificate, extension, -1) == 1;
+    X509_EXTENSION_free(extension);
+    return ok;
+}
+
+bool SendAll(int fd, const char *data, std::size_t size) {
+    while (size > 0) {
+        auto n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool SslWriteAll(SSL *ssl, const char *data, std::size_t size) {
+    while (size > 0) {
+        int n = SSL_write(ssl, data, static_cast<int>(std::min<std::size_t>(size, 1 << 30)));
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+int ConnectLoopback(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+// The client side stores the latest session a handshake (or a TLS 1.3
+// NewSessionTicket after it) produced, in the slot the SSL points at.
+int SaveSession(SSL *ssl, SSL_SESSION *session) {
+    auto *slot = static_cast<SSL_SESSION **>(SSL_get_app_data(ssl));
+    if (slot == nullptr) return 0;
+    if (*slot != nullptr) SSL_SESSION_free(*slot);
+    *slot = session;
+    return 1;  // keeps the reference
+}
+
+int SelectAlpn(SSL *, const unsigned char **out, unsigned char *outlen, const unsigned char *in, unsigned int inlen,
+               void *arg) {
+    const auto *protocols = static_cast<const std::string *>(arg);
+    unsigned char *selected = nullptr;
+    if (SSL_select_next_proto(&selected, outlen, reinterpret_cast<const unsigned char *>(protocols->data()),
+                              static_cast<unsigned int>(protocols->size()), in,
+                              inlen) != OPENSSL_NPN_NEGOTIATED) {
+        return SSL_TLSEXT_ERR_NOACK;
+    }
+    *out = selected;
+    return SSL_TLSEXT_ERR_OK;
+}
+
+}  // namespace
+
+TlsIdentity::~TlsIdentity() {
+    if (!certificate_file.empty()) unlink(certificate_file.c_str());
+    X509_free(certificate);
+    EVP_PKEY_free(key);
+}
+
+std::unique_ptr<TlsIdentity> MakeSelfSignedIdentity(const std::string &key_type) {
+    auto identity = std::make_unique<TlsIdentity>();
+    if (key_type == "ec") {
+        identity->key = EVP_EC_gen("P-256");
+    } else if (key_type == "rsa") {
+        identity->key = EVP_RSA_gen(2048);
+    } else {
+        std::cerr << "Error: --tls-key must be ec or rsa\n";
+        return nullptr;
+    }
+    identity->certificate = X509_new();
+    X509 *certificate = identity->certificate;
+    if (identity->key == nullptr || certificate == nullptr) {
+        std::cerr << "Error: cannot generate a " << key_type << " key: " << OpenSslError() << "\n";
+        return nullptr;
+    }
+
+    X509_set_version(certificate, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+    X509_gmtime_adj(X509_getm_notBefore(certificate), -3600);
+    X509_gmtime_adj(X509_getm_notAfter(certificate), 24 * 3600);
+    X509_set_pubkey(certificate, identity->key);
+    X509_NAME *name = X509_get_subject_name(certificate);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char *>("localhost"), -1,
+                               -1, 0);
+    X509_set_issuer_name(certificate, name);
+    if (!AddExtension(certificate, NID_basic_constraints, "critical,CA:TRUE") ||
+        !AddExtension(certificate, NID_subject_alt_name, "DNS:localhost,IP:127.0.0.1") ||
+        X509_sign(certificate, identity->key, EVP_sha256()) == 0) {
+        std::cerr << "Error: cannot sign the test certificate: " << OpenSslError() << "\n";
+        return nullptr;
+    }
+
+    BIO *bio = BIO_new(BIO_s_mem());
+    char *pem = nullptr;
+    if (bio != nullptr && PEM_write_bio_X509(bio, certificate) == 1) {
+        auto size = BIO_get_mem_data(bio, &pem);
+        identity->certificate_pem.assign(pem, static_cast<std::size_t>(size));
+    }
+    BIO_free(bio);
+
+    char path[] = "/tmp/gcsbench-tls-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        std::cerr << "Error: cannot create the certificate file: " << std::strerror(errno) << "\n";
+        return nullptr;
+    }
+    identity->certificate_file = path;
+    auto size = identity->certificate_pem.size();
+    bool written = size > 0 && write(fd, identity->certificate_pem.data(), size) == static_cast<ssize_t>(size);
+    if (close(fd) != 0 || !written) {
+        std::cerr << "Error: cannot write " << path << "\n";
+        return nullptr;
+    }
+    return identity;
+}
+
+TlsProxy::TlsProxy(const TlsIdentity &identity, std::string upstream, std::string alpn, std::string ciphersuites)
+    : identity_(identity), upstream_(std::move(upstream)), ciphersuites_(std::move(ciphersuites)) {
+    alpn_.push_back(static_cast<char>(alpn.size()));
+    alpn_ += alpn;
+}
+
+TlsProxy::~TlsProxy() {
+    stopping_ = true;
+    if (listen_fd_ >= 0) shutdown(listen_fd_, SHUT_RDWR);
+    if (accept_thread_.joinable()) accept_thread_.join();
+    if (listen_fd_ >= 0) close(listen_fd_);
+
+    std::vector<std::thread> connections;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        for (int fd : open_fds_) shutdown(fd, SHUT_RDWR);
+        connections.swap(connections_);
+    }
+    for (auto &thread : connections) thread.join();
+    SSL_CTX_free(ctx_);
+}
+
+bool TlsProxy::Start() {
+    // OpenSSL writes to the sockets with write(); a peer that hangs up (a
+    // client closing before reading its session tickets) must not kill us.
+    std::signal(SIGPIPE, SIG_IGN);
+    ctx_ = SSL_CTX_new(TLS_server_method());
+    if (ctx_ == nullptr || SSL_CTX_use_certificate(ctx_, identity_.certificate) != 1 ||
+        SSL_CTX_use_PrivateKey(ctx_, identity_.key) != 1) {
+        std::cerr << "Error: cannot configure the TLS proxy: " << OpenSslError() << "\n";
+        return false;
+    }
+    SSL_CTX_set_min_proto_version(ctx_, TLS1_2_VERSION);
+    if (!ciphersuites_.empty()) {
+        if (SSL_CTX_set_ciphersuites(ctx_, ciphersuites_.c_str()) != 1) {
+            std::cerr << "Error: unknown TLS 1.3 ciphersuite: " << ciphersuites_ << "\n";
+            return false;
+        }
+        SSL_CTX_set_min_proto_version(ctx_, TLS1_3_VERSION);
+    }
+    SSL_CTX_set_alpn_select_cb(ctx_, SelectAlpn, &alpn_);
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (listen_fd_ < 0 || bind(listen_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        listen(listen_fd_, 128) != 0 ||
+        getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&address), &length) != 0) {
+        std::cerr << "Error: cannot listen on 127.0.0.1: " << std::strerror(errno) << "\n";
+        return false;
+    }
+    port_ = ntohs(address.sin_port);
+    accept_thread_ = std::thread([this] { Accept(); });
+    return true;
+}
+
+TlsProxy::Counters TlsProxy::Snapshot() const {
+    Counters counters;
+    counters.handshakes = handshakes_.load();
+    counters.resumed = resumed_.load();
+    counters.failed = failed_.load();
+    counters.handshake_cpu_ms = handshake_cpu_us_.load() / 1000.0;
+    counters.cpu_ms = cpu_us_.load() / 1000.0;
+    counters.bytes = bytes_.load();
+    return counters;
+}
+
+void TlsProxy::Accept() {
+    while (!stopping_) {
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (!stopping_) std::cerr << "Error: TLS proxy accept failed: " << std::strerror(errno) << "\n";
+            return;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        std::lock_guard<std::mutex> lock(mu_);
+        open_fds_.insert(fd);
+        connections_.emplace_back([this, fd] { Serve(fd); });
+    }
+}
+
+int TlsProxy::ConnectUpstream() {
+    auto colon = upstream_.rfind(':');
+    if (upstream_.empty() || colon == std::string::npos) {
+        std::cerr << "Error: TLS proxy has no upstream host:port to forward to\n";
+        return -1;
+    }
+    auto host = upstream_.substr(0, colon);
+    if (host.size() > 2 && host.front() == '[' && host.back() == ']') host = host.substr(1, host.size() - 2);
+    addrinfo hints{};
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addresses = nullptr;
+    if (getaddrinfo(host.c_str(), upstream_.substr(colon + 1).c_str(), &hints, &addresses) != 0) {
+        std::cerr << "Error: cannot resolve TLS proxy upstream " << upstream_ << "\n";
+        return -1;
+    }
+    int fd = -1;
+    for (auto *a = addresses; a != nullptr && fd < 0; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype | SOCK_CLOEXEC, a->ai_protocol);
+        if (fd >= 0 && connect(fd, a->ai_addr, a->ai_addrlen) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    if (fd < 0) {
+        std::cerr << "Error: cannot connect to TLS proxy upstream " << upstream_ << ": " << std::strerror(errno)
+                  << "\n";
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+void TlsProxy::Serve(int fd) {
+    SSL *ssl = SSL_new(ctx_);
+    SSL_set_fd(ssl, fd);
+    auto cpu_start = ThreadCpuTimeMs();
+    bool accepted = SSL_accept(ssl) == 1;
+    auto cpu_now = ThreadCpuTimeMs();
+    auto handshake_us = static_cast<uint64_t>(1000.0 * (cpu_now - cpu_start));
+    handshake_cpu_us_ += handshake_us;
+    cpu_us_ += handshake_us;
+    if (!accepted) {
+        ++failed_;
+        ERR_clear_error();
+    } else {
+        ++handshakes_;
+        if (SSL_session_reused(ssl)) ++resumed_;
+    }
+
+    int upstream_fd = -1;
+    std::vector<char> buffer(kPumpBufferSize);
+    while (accepted && !stopping_) {
+        // Bytes OpenSSL already decrypted do not make the socket readable.
+        bool client_ready = SSL_pending(ssl) > 0;
+        bool upstream_ready = false;
+        if (!client_ready) {
+            pollfd fds[2] = {{fd, POLLIN, 0}, {upstream_fd, POLLIN, 0}};
+            if (poll(fds, upstream_fd >= 0 ? 2 : 1, -1) < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            client_ready = fds[0].revents != 0;
+            upstream_ready = upstream_fd >= 0 && fds[1].revents != 0;
+        }
+        cpu_start = ThreadCpuTimeMs();
+        bool open = true;
+        if (client_ready) {
+            int n = SSL_read(ssl, buffer.data(), static_cast<int>(buffer.size()));
+            if (n <= 0) {
+                open = false;
+            } else {
+                if (upstream_fd < 0) upstream_fd = ConnectUpstream();
+                open = upstream_fd >= 0 && SendAll(upstream_fd, buffer.data(), static_cast<std::size_t>(n));
+            }
+        }
+        if (open && upstream_ready) {
+            auto n = recv(upstream_fd, buffer.data(), buffer.size(), 0);
+            if (n <= 0) {
+                open = n < 0 && errno == EINTR;
+            } else {
+                bytes_ += static_cast<uint64_t>(n);
+                open = SslWriteAll(ssl, buffer.data(), static_cast<std::size_t>(n));
+            }
+        }
+        cpu_us_ += static_cast<uint64_t>(1000.0 * (ThreadCpuTimeMs() - cpu_start));
+        if (!open) break;
+    }
+
+    if (accepted) SSL_shutdown(ssl);
+    SSL_free(ssl);
+    if (upstream_fd >= 0) close(upstream_fd);
+    std::lock_guard<std::mutex> lock(mu_);
+    open_fds_.erase(fd);
+    close(fd);
+}
+
+HandshakeStats MeasureHandshakes(int port, const std::string &ca_file, int tls_version, bool resume, int count) {
+    HandshakeStats stats;
+    SSL_CTX *ctx = SSL_CTX_new(TLS_client_method());
+    if (ctx == nullptr || SSL_CTX_load_verify_locations(ctx, ca_file.c_str(), nullptr) != 1) {
+        std::cerr << "Error: cannot configure the TLS client: " << OpenSslError() << "\n";
+        SSL_CTX_free(ctx);
+        return stats;
+    }
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, nullptr);
+    SSL_CTX_set_min_proto_version(ctx, tls_version);
+    SSL_CTX_set_max_proto_version(ctx, tls_version);
+    if (resume) {
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ctx, SaveSession);
+    } else {
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+        SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+    }
+
+    SSL_SESSION *session = nullptr;
+    // With resumption the first handshake only obtains a session.
+    for (int i = resume ? -1 : 0; i < count; ++i) {
+        bool measured = i >= 0;
+        if (measured) ++stats.attempted;
+        int fd = ConnectLoopback(port);
+        if (fd < 0) {
+            std::cerr << "Error: cannot connect to 127.0.0.1:" << port << ": " << std::strerror(errno) << "\n";
+            continue;
+        }
+        SSL *ssl = SSL_new(ctx);
+        SSL_set_fd(ssl, fd);
+        SSL_set_tlsext_host_name(ssl, "localhost");
+        SSL_set1_host(ssl, "localhost");
+        SSL_set_app_data(ssl, &session);
+        if (resume && session != nullptr) SSL_set_session(ssl, session);
+
+        auto start_time = BenchmarkClock::now();
+        auto cpu_start = ThreadCpuTimeMs();
+        bool connected = SSL_connect(ssl) == 1;
+        auto cpu_ms = ThreadCpuTimeMs() - cpu_start;
+        auto elapsed = std::chrono::duration<double, std::milli>(BenchmarkClock::now() - start_time).count();
+
+        if (!connected) {
+            std::cerr << "Error: TLS handshake with 127.0.0.1:" << port << " failed: " << OpenSslError() << "\n";
+        } else {
+            if (measured) {
+                ++stats.succeeded;
+                stats.latencies_ms.push_back(elapsed);
+                stats.client_cpu_ms += cpu_ms;
+                if (SSL_session_reused(ssl)) ++stats.resumed;
+            }
+            // TLS 1.3 tickets arrive after the handshake; read until the
+            // callback has one (the server sends no application data).
+            SSL_SESSION *before = session;
+            if (resume && tls_version == TLS1_3_VERSION) {
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                char byte;
+                while (session == before) {
+                    pollfd pfd{fd, POLLIN, 0};
+                    if (poll(&pfd, 1, kTicketWaitMs) <= 0) break;
+                    int n = SSL_read(ssl, &byte, 1);
+                    if (n <= 0 && SSL_get_error(ssl, n) != SSL_ERROR_WANT_READ) break;
+                }
+                ERR_clear_error();
+            }
+            SSL_shutdown(ssl);
+        }
+        SSL_free(ssl);
+        close(fd);
+    }
+    if (session != nullptr) SSL_SESSION_free(session);
+    SSL_CTX_free(ctx);
+    return stats;
+}
+
+bool MeasureCipherThroughput(const std::string &cipher,
+                             std::size_t record_size,
+                             std::size_t total_bytes,
+                             CipherThroughput &result) {
+    EVP_CIPHER *aead = EVP_CIPHER_fetch(nullptr, cipher.c_str(), nullptr);
+    EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+    if (aead == nullptr || ctx == nullptr || EVP_CIPHER_get_iv_length(aead) != static_cast<int>(kAeadNonceSize)) {
+        std::cerr << "Error: AEAD " << cipher << " is not available: " << OpenSslError() << "\n";
+        EVP_CIPHER_free(aead);
+        EVP_CIPHER_CTX_free(ctx);
+        return false;
+    }
+
+    std::vector<unsigned char> key(static_cast<std::size_t>(EVP_CIPHER_get_key_length(aead)), 0x42);
+    std::vector<unsigned char> plaintext(record_size, 0x5a);
+    std::vector<unsigned char> ciphertext(record_size);
+    std::vector<unsigned char> decrypted(record_size);
+    unsigned char nonce[kAeadNonceSize] = {};
+    unsigned char header[5] = {0x17, 0x03, 0x03, 0, 0};  // TLS 1.3 record header, the AAD
+    unsigned char tag[kAeadTagSize];
+    std::size_t records = std::max<std::size_t>(1, total_bytes / std::max<std::size_t>(record_size, 1));
+    int length = 0;
+
+    auto seal = [&](uint64_t sequence) {
+        std::memcpy(nonce + kAeadNonceSize - sizeof(sequence), &sequence, sizeof(sequence));
+        return EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, nonce) == 1 &&
+               EVP_EncryptUpdate(ctx, nullptr, &length, header, sizeof(header)) == 1 &&
+               EVP_EncryptUpdate(ctx, ciphertext.data(), &length, plaintext.data(),
+                                 static_cast<int>(record_size)) == 1 &&
+               EVP_EncryptFinal_ex(ctx, ciphertext.data() + length, &length) == 1 &&
+               EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, sizeof(tag), tag) == 1;
+    };
+    bool ok = EVP_EncryptInit_ex(ctx, aead, nullptr, key.data(), nullptr) == 1;
+    auto start_time = BenchmarkClock::now();
+    for (std::size_t i = 0; ok && i < records; ++i) ok = seal(i);
+    auto encrypt_s = std::chrono::duration<double>(BenchmarkClock::now() - start_time).count();
+
+    // Opening the same sealed record repeatedly costs what opening distinct
+    // ones would; the nonce of the last seal stays in place.
+    ok = ok && EVP_DecryptInit_ex(ctx, aead, nullptr, key.data(), nullptr) == 1;
+    start_time = BenchmarkClock::now();
+    auto cpu_start = ThreadCpuTimeMs();
+    for (std::size_t i = 0; ok && i < records; ++i) {
+        ok = EVP_DecryptInit_ex(ctx, nullptr, nullptr, nullptr, nonce) == 1 &&
+             EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, sizeof(tag), tag) == 1 &&
+             EVP_DecryptUpdate(ctx, nullptr, &length, header, sizeof(header)) == 1 &&
+             EVP_DecryptUpdate(ctx, decrypted.data(), &length, ciphertext.data(), static_cast<int>(record_size)) ==
+                 1 &&
+             EVP_DecryptFinal_ex(ctx, decrypted.data() + length, &length) == 1;
+    }
+    auto decrypt_cpu_ms = ThreadCpuTimeMs() - cpu_start;
+    auto decrypt_s = std::chrono::duration<double>(BenchmarkClock::now() - start_time).count();
+    EVP_CIPHER_CTX_free(ctx);
+    EVP_CIPHER_free(aead);
+    if (!ok || decrypted != plaintext) {
+        std::cerr << "Error: " << cipher << " round trip failed: " << OpenSslError() << "\n";
+        return false;
+    }
+
+    double mb = static_cast<double>(records * record_size) / kMiB;
+    result.encrypt_mbs = encrypt_s > 0 ? mb / encrypt_s : 0.0;
+    result.decrypt_mbs = decrypt_s > 0 ? mb / decrypt_s : 0.0;
+    result.decrypt_cpu_ns_per_byte = 1e6 * decrypt_cpu_ms / static_cast<double>(records * record_size);
+    return true;
+}
+
+}  // namespace gcsbench
@@ -0,0 +1,128 @@
+#ifndef GCSBENCH_TLS_H
+#define GCSBENCH_TLS_H
+
+#include "gcsbench/common.h"
+
+#include <openssl/ssl.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gcsbench {
+
+// A throwaway self-signed certificate for localhost and 127.0.0.1, also
+// written to a PEM file, that the clients trust as their only CA.
+struct TlsIdentity {
+    EVP_PKEY *key = nullptr;
+    X509 *certificate = nullptr;
+    std::string certificate_pem;
+    std::string certificate_file;
+
+    TlsIdentity() = default;
+    ~TlsIdentity();
+    TlsIdentity(const TlsIdentity &) = delete;
+    TlsIdentity &operator=(const TlsIdentity &) = delete;
+};
+
+// `key_type` is "ec" (P-256) or "rsa" (2048 bits). Returns nullptr (after
+// logging) on failure.
+std::unique_ptr<TlsIdentity> MakeSelfSignedIdentity(const std::string &key_type);
+
+// A local TLS-enabled stand-in for the storage endpoint: terminates TLS on a
+// loopback port and forwards the plaintext to `upstream` (host:port, e.g.
+// the emulator), one thread per connection. The upstream connection is only
+// opened once the client sends data, so handshake-only clients need no
+// upstream. Counts handshakes, resumptions and the CPU its threads spend, so
+// that can be told apart from the client's share of process CPU.
+class TlsProxy {
+public:
+    struct Counters {
+        uint64_t handshakes = 0;
+        uint64_t resumed = 0;
+        uint64_t failed = 0;
+        double handshake_cpu_ms = 0.0;
+        double cpu_ms = 0.0;  // handshakes and record processing
+        uint64_t bytes = 0;   // upstream to client
+    };
+
+    // `alpn` is the one protocol offered ("http/1.1", "h2"); `ciphersuites`
+    // restricts TLS 1.3 suites (OpenSSL names, colon separated) and limits
+    // the proxy to TLS 1.3 when set.
+    TlsProxy(const TlsIdentity &identity, std::string upstream, std::string alpn, std::string ciphersuites = "");
+    ~TlsProxy();
+
+    TlsProxy(const TlsProxy &) = delete;
+    TlsProxy &operator=(const TlsProxy &) = delete;
+
+    // Listens on 127.0.0.1 with an ephemeral port. Returns false (after
+    // logging) on failure.
+    bool Start();
+    int Port() const { return port_; }
+    Counters Snapshot() const;
+
+private:
+    void Accept();
+    void Serve(int fd);
+    int ConnectUpstream();
+
+    const TlsIdentity &identity_;
+    std::string upstream_;
+    std::string alpn_;  // wire format: length-prefixed
+    std::string ciphersuites_;
+    SSL_CTX *ctx_ = nullptr;
+    int listen_fd_ = -1;
+    int port_ = 0;
+
+    std::atomic<bool> stopping_{false};
+    std::thread accept_thread_;
+    std::mutex mu_;
+    std::vector<std::thread> connections_;
+    std::set<int> open_fds_;
+
+    std::atomic<uint64_t> handshakes_{0};
+    std::atomic<uint64_t> resumed_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> handshake_cpu_us_{0};
+    std::atomic<uint64_t> cpu_us_{0};
+    std::atomic<uint64_t> bytes_{0};
+};
+
+struct HandshakeStats {
+    int attempted = 0;
+    int succeeded = 0;
+    int resumed = 0;
+    std::vector<double> latencies_ms;  // SSL_connect only, TCP connect excluded
+    double client_cpu_ms = 0.0;        // this thread's CPU inside SSL_connect
+};
+
+// `count` handshakes with 127.0.0.1:port, pinned to `tls_version`
+// (TLS1_2_VERSION or TLS1_3_VERSION), verifying against `ca_file`. With
+// `resume` each handshake offers the session (ticket) of the previous one,
+// after an unmeasured first handshake that obtains it.
+HandshakeStats MeasureHandshakes(int port, const std::string &ca_file, int tls_version, bool resume, int count);
+
+struct CipherThroughput {
+    double encrypt_mbs = 0.0;
+    double decrypt_mbs = 0.0;
+    double decrypt_cpu_ns_per_byte = 0.0;
+};
+
+// Seals and opens `total_bytes` in `record_size` records with an AEAD
+// (OpenSSL name, e.g. "aes-128-gcm", "chacha20-poly1305") the way a TLS
+// record layer does, on one thread. Returns false (after logging) if the
+// cipher is unavailable.
+bool MeasureCipherThroughput(const std::string &cipher,
+                             std::size_t record_size,
+                             std::size_t total_bytes,
+                             CipherThroughput &result);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_TLS_H
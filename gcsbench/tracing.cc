@@ -0,0 +1,228 @@
+#include "gcsbench/tracing.h"
+
+#include "gcsbench/workloads.h"
+
+#ifdef GCS_BENCHMARK_HAVE_OPENTELEMETRY
+#include <opentelemetry/sdk/trace/span_data.h>
+#include <opentelemetry/trace/provider.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <type_traits>
+#include <unordered_map>
+
+#ifdef GCS_BENCHMARK_HAVE_OPENTELEMETRY
+
+namespace gcsbench {
+
+namespace {
+
+template <typename T>
+void AppendAttributeValue(std::ostringstream &os, const T &value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        os << value;
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        os << +value;
+    } else {
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            if (i != 0) os << ',';
+            AppendAttributeValue(os, static_cast<typename T::value_type>(value[i]));
+        }
+    }
+}
+
+std::string AttributeToString(const otel::sdk::common::OwnedAttributeValue &value) {
+    return otel::nostd::visit(
+        [](const auto &v) {
+            std::ostringstream os;
+            AppendAttributeValue(os, v);
+            return os.str();
+        },
+        value);
+}
+
+template <typename Id>
+std::string IdToHex(const Id &id) {
+    char hex[2 * Id::kSize];
+    id.ToLowerBase16(hex);
+    return std::string(hex, sizeof(hex));
+}
+
+void WriteSpanJson(std::ostream &out, const RecordedSpan &span) {
+    out << "{\"name\":\"" << JsonEscape(span.name) << "\",\"trace_id\":\"" << span.trace_id << "\",\"span_id\":\""
+        << span.span_id << "\",\"parent_span_id\":\"" << span.parent_span_id << "\",\"start_unix_ns\":"
+        << span.start_unix_ns << ",\"duration_ns\":" << span.duration_ns << ",\"attributes\":{";
+    bool first = true;
+    for (const auto &attribute : span.attributes) {
+        out << (first ? "" : ",") << "\"" << JsonEscape(attribute.first) << "\":\"" << JsonEscape(attribute.second)
+            << "\"";
+        first = false;
+    }
+    out << "}}\n";
+}
+
+// Buckets a client-library span by name. Span names differ between library
+// versions and transports, so the summary also lists the heaviest names.
+std::string SpanCategory(const std::string &name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+    auto has_any = [&](std::initializer_list<const char *> needles) {
+        return std::any_of(needles.begin(), needles.end(),
+                           [&](const char *needle) { return lower.find(needle) != std::string::npos; });
+    };
+    if (lower.rfind("benchmark.", 0) == 0) return "outside library";
+    if (has_any({"auth", "token", "credential", "oauth"})) return "auth";
+    if (has_any({"backoff", "retry", "sleep"})) return "retry";
+    if (has_any({"decode", "parse", "deserial", "checksum", "hash", "crc"})) return "decode";
+    if (has_any({"http", "grpc", "google.storage.v2", "curl", "connect", "send", "recv", "tls", "dns"})) {
+        return "transport";
+    }
+    return "other library";
+}
+
+}  // namespace
+
+void PrintSpanBreakdown(const std::string &type, const std::vector<RecordedSpan> &spans) {
+    std::unordered_map<std::string, int64_t> child_ns;
+    for (const auto &span : spans) {
+        if (!span.parent_span_id.empty()) child_ns[span.trace_id + span.parent_span_id] += span.duration_ns;
+    }
+    std::map<std::string, double> by_category;
+    std::map<std::string, double> by_name;
+    std::map<std::string, std::size_t> count_by_name;
+    double total_ms = 0.0;
+    std::size_t sampled_reads = 0;
+    for (const auto &span : spans) {
+        auto it = child_ns.find(span.trace_id + span.span_id);
+        auto self_ns = std::max<int64_t>(span.duration_ns - (it == child_ns.end() ? 0 : it->second), 0);
+        double self_ms = self_ns / 1e6;
+        by_category[SpanCategory(span.name)] += self_ms;
+        by_name[span.name] += self_ms;
+        ++count_by_name[span.name];
+        if (span.name == "benchmark.read") {
+            total_ms += span.duration_ns / 1e6;
+            ++sampled_reads;
+        }
+    }
+
+    std::cout << "\n==== " << type << " Time By Category (" << sampled_reads << " sampled reads) ====\n";
+    if (sampled_reads == 0) {
+        std::cout << "No sampled reads.\n";
+        return;
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(18) << "Category" << std::setw(14) << "ms/read" << "Share\n";
+    for (const char *category : {"auth", "retry", "transport", "decode", "other library", "outside library"}) {
+        double ms = by_category[category];
+        std::cout << std::setw(18) << category << std::setw(14) << ms / sampled_reads << 100.0 * ms / total_ms
+                  << "%\n";
+    }
+
+    std::vector<std::pair<double, std::string>> heaviest;
+    for (const auto &entry : by_name) heaviest.emplace_back(entry.second, entry.first);
+    std::sort(heaviest.rbegin(), heaviest.rend());
+    heaviest.resize(std::min<std::size_t>(heaviest.size(), 10));
+    std::cout << "\nHeaviest spans by self time:\n";
+    for (const auto &entry : heaviest) {
+        std::cout << "  " << std::setw(56) << entry.second << std::setw(10) << count_by_name[entry.second]
+                  << entry.first / sampled_reads << " ms/read\n";
+    }
+    std::cout << std::right << std::defaultfloat;
+}
+
+OpenLoopResult RunTracedReads(gcs::Client &client,
+                              const std::string &client_name,
+                              const std::string &sampling,
+                              int num_iterations,
+                              int reads_per_iteration,
+                              const std::string &bucket,
+                              const std::string &object_name,
+                              std::size_t file_size,
+                              std::size_t read_size,
+                              double &cpu_ms) {
+    auto tracer = otel::trace::Provider::GetTracerProvider()->GetTracer("gcs-client-benchmark");
+    std::mt19937_64 gen(7);  // same offsets for every client and sampling ratio
+    std::uniform_int_distribution<std::size_t> pick(0, file_size > read_size ? file_size - read_size : 0);
+    std::vector<char> buffer(read_size);
+
+    OpenLoopResult result;
+    auto cpu_start = ProcessCpuTimeMs();
+    auto run_start = BenchmarkClock::now();
+    for (int i = 1; i <= num_iterations; ++i) {
+        std::size_t iteration_bytes = 0;
+        auto iteration_start = BenchmarkClock::now();
+        for (int r = 0; r < reads_per_iteration; ++r) {
+            auto offset = pick(gen);
+            auto span = tracer->StartSpan("benchmark.read", {{"benchmark.client", client_name},
+                                                             {"benchmark.sampling", sampling},
+                                                             {"benchmark.iteration", static_cast<int64_t>(i)},
+                                                             {"benchmark.offset", static_cast<int64_t>(offset)},
+                                                             {"benchmark.length", static_cast<int64_t>(read_size)}});
+            auto start_time = BenchmarkClock::now();
+            std::size_t bytes_read = 0;
+            bool ok;
+            {
+                auto scope = tracer->WithActiveSpan(span);
+                ok = ReadRangeInto(client, bucket, object_name, offset, read_size, buffer.data(), bytes_read);
+            }
+            span->End();
+            iteration_bytes += bytes_read;
+            if (!ok) {
+                ++result.failures;
+                continue;
+            }
+            result.latencies_ms.push_back(
+                std::chrono::duration<double, std::milli>(BenchmarkClock::now() - start_time).count());
+        }
+        result.bytes_read += iteration_bytes;
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(BenchmarkClock::now() - iteration_start).count();
+        std::cout << "[" << GetTimestamp() << "] Iteration " << i << ": " << iteration_bytes / kMiB << " MB in " << ms
+                  << " ms\n";
+    }
+    result.duration_s = std::chrono::duration<double>(BenchmarkClock::now() - run_start).count();
+    cpu_ms = ProcessCpuTimeMs() - cpu_start;
+    result.service_ms = result.latencies_ms;
+    return result;
+}
+
+std::unique_ptr<otel_sdk::Recordable> RecordingSpanExporter::MakeRecordable() noexcept {
+    return std::unique_ptr<otel_sdk::Recordable>(new otel_sdk::SpanData);
+}
+
+otel::sdk::common::ExportResult RecordingSpanExporter::Export(
+    const otel::nostd::span<std::unique_ptr<otel_sdk::Recordable>> &spans) noexcept {
+    std::lock_guard<std::mutex> lock(store_->mu);
+    for (auto &recordable : spans) {
+        std::unique_ptr<otel_sdk::SpanData> data(static_cast<otel_sdk::SpanData *>(recordable.release()));
+        if (!data) continue;
+        RecordedSpan span;
+        span.name = std::string(data->GetName());
+        span.trace_id = IdToHex(data->GetTraceId());
+        span.span_id = IdToHex(data->GetSpanId());
+        span.parent_span_id = data->GetParentSpanId().IsValid() ? IdToHex(data->GetParentSpanId()) : "";
+        span.start_unix_ns = data->GetStartTime().time_since_epoch().count();
+        span.duration_ns = data->GetDuration().count();
+        for (const auto &attribute : data->GetAttributes()) {
+            span.attributes[attribute.first] = AttributeToString(attribute.second);
+        }
+        if (store_->file) WriteSpanJson(*store_->file, span);
+        store_->spans.push_back(std::move(span));
+    }
+    return otel::sdk::common::ExportResult::kSuccess;
+}
+
+bool RecordingSpanExporter::ForceFlush(std::chrono::microseconds) noexcept {
+    std::lock_guard<std::mutex> lock(store_->mu);
+    if (store_->file) store_->file->flush();
+    return true;
+}
+
+}  // namespace gcsbench
+
+#endif
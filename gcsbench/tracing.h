@@ -0,0 +1,90 @@
+#ifndef GCSBENCH_TRACING_H
+#define GCSBENCH_TRACING_H
+
+#include "gcsbench/common.h"
+#include "gcsbench/executors.h"
+
+#include "google/cloud/storage/client.h"
+
+#ifdef GCS_BENCHMARK_HAVE_OPENTELEMETRY
+#include <opentelemetry/sdk/trace/exporter.h>
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef GCS_BENCHMARK_HAVE_OPENTELEMETRY
+namespace gcsbench {
+
+namespace otel = ::opentelemetry;
+namespace otel_sdk = ::opentelemetry::sdk::trace;
+
+// A finished span, flattened from the SDK's SpanData.
+struct RecordedSpan {
+    std::string name;
+    std::string trace_id;
+    std::string span_id;
+    std::string parent_span_id;
+    int64_t start_unix_ns = 0;
+    int64_t duration_ns = 0;
+    std::map<std::string, std::string> attributes;
+};
+
+// Spans exported by one tracer provider, optionally mirrored to a JSON lines
+// file shared by every provider in the run.
+struct SpanStore {
+    std::mutex mu;
+    std::vector<RecordedSpan> spans;
+    std::ofstream *file = nullptr;
+};
+
+// Keeps every finished span in memory so the run can be summarized, instead
+// of shipping them to a collector.
+class RecordingSpanExporter : public otel_sdk::SpanExporter {
+public:
+    explicit RecordingSpanExporter(std::shared_ptr<SpanStore> store) : store_(std::move(store)) {}
+
+    std::unique_ptr<otel_sdk::Recordable> MakeRecordable() noexcept override;
+
+    otel::sdk::common::ExportResult Export(
+        const otel::nostd::span<std::unique_ptr<otel_sdk::Recordable>> &spans) noexcept override;
+
+    bool ForceFlush(std::chrono::microseconds) noexcept override;
+
+    bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+private:
+    std::shared_ptr<SpanStore> store_;
+};
+
+// Attributes each span's self time (its duration minus that of its children)
+// to a category, so nested library spans are not counted twice. The self time
+// of the benchmark's own read spans is time outside any library span.
+void PrintSpanBreakdown(const std::string &type, const std::vector<RecordedSpan> &spans);
+
+// Runs `reads_per_iteration` random range reads per iteration with one client,
+// wrapping each read in a root "benchmark.read" span carrying the iteration,
+// offset and length, so the library's spans for that read are its children.
+OpenLoopResult RunTracedReads(gcs::Client &client,
+                              const std::string &client_name,
+                              const std::string &sampling,
+                              int num_iterations,
+                              int reads_per_iteration,
+                              const std::string &bucket,
+                              const std::string &object_name,
+                              std::size_t file_size,
+                              std::size_t read_size,
+                              double &cpu_ms);
+
+}  // namespace gcsbench
+#endif
+
+#endif  // GCSBENCH_TRACING_H
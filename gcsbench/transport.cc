@@ -0,0 +1,418 @@
+#include "gcsbench/transport.h"
+
+#include "gcsbench/clients.h"
+#include "gcsbench/http_backends.h"
+
+#include "google/cloud/common_options.h"
+#include "google/cloud/credentials.h"
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/storage/grpc_plugin.h"
+#include <curl/curl.h>
+#include <grpc/grpc_security_constants.h>
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/security/credentials.h>
+
+#include <arpa/inet.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace gcsbench {
+
+namespace {
+
+constexpr auto kProbeTimeout = std::chrono::seconds(10);
+
+TransportSelection g_selection;
+std::string g_grpc_path_label;
+std::string g_json_path_label;
+
+bool ReadFile(const std::string &path, std::string &contents) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+// The same credentials for the client and the probe channels, so the probe
+// negotiates what the client does. nullptr keeps the library default.
+std::shared_ptr<grpc::ChannelCredentials> GrpcChannelCredentials(const TransportSelection &selection) {
+    if (!selection.tls || selection.grpc_emulator) return grpc::InsecureChannelCredentials();
+    if (selection.grpc_security == "alts") {
+        // ALTS only works on Google Cloud, where the metadata server has tokens.
+        return grpc::CompositeChannelCredentials(
+            grpc::experimental::AltsCredentials(grpc::experimental::AltsCredentialsOptions()),
+            grpc::GoogleComputeEngineCredentials());
+    }
+    if (selection.grpc_security == "tls") {
+        grpc::SslCredentialsOptions ssl;
+        if (!selection.ca_file.empty()) ReadFile(selection.ca_file, ssl.pem_root_certs);
+        auto credentials = grpc::SslCredentials(ssl);
+        if (selection.access_token.empty()) return credentials;
+        return grpc::CompositeChannelCredentials(credentials, grpc::AccessTokenCredentials(selection.access_token));
+    }
+    return nullptr;
+}
+
+std::size_t DiscardBody(char *, std::size_t size, std::size_t count, void *) { return size * count; }
+
+std::string Lower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+// "direct/alts x3, cloudpath/tls x1 (ipv6:[...]:443, ...)"
+std::string Summarize(const std::vector<EffectivePath> &paths) {
+    std::map<std::string, int> counts;
+    std::set<std::string> peers;
+    for (const auto &path : paths) {
+        ++counts[path.path + "/" + path.security];
+        if (!path.peer.empty()) peers.insert(path.peer);
+    }
+    std::string label;
+    for (const auto &count : counts) {
+        if (!label.empty()) label += ", ";
+        label += count.first + " x" + std::to_string(count.second);
+    }
+    std::string peer_list;
+    for (const auto &peer : peers) {
+        peer_list += (peer_list.empty() ? "" : ", ") + peer;
+    }
+    return peer_list.empty() ? label : label + " (" + peer_list + ")";
+}
+
+}  // namespace
+
+std::string TransportSelection::GrpcTarget() const {
+    if (!grpc_endpoint.empty()) return grpc_endpoint;
+    if (grpc_path == "direct") return "google-c2p:///storage.googleapis.com";
+    if (grpc_path == "cloudpath") return "dns:///storage.googleapis.com";
+    return "storage.googleapis.com";
+}
+
+std::string TransportSelection::JsonEndpoint() const {
+    if (!json_endpoint.empty()) return json_endpoint;
+    return tls ? "https://storage.googleapis.com" : "http://storage.googleapis.com";
+}
+
+std::string TransportSelection::Label() const {
+    return "grpc=" + grpc_path + "/" + (tls ? grpc_security : "insecure") +
+           (grpc_channels > 0 ? " channels=" + std::to_string(grpc_channels) : "") +
+           (grpc_flow_control.IsDefault() ? "" : " " + grpc_flow_control.Label()) + " json=http-" +
+           (http_version.empty() ? "default" : http_version) + "/" + (tls ? "tls" : "insecure");
+}
+
+bool ParseTransportSelection(const BenchmarkFlags &flags, TransportSelection &selection) {
+    selection.grpc_path = GetFlag(flags, "grpc-path", "default");
+    selection.grpc_security = GetFlag(flags, "grpc-security", "default");
+    selection.grpc_channels = std::stoi(GetFlag(flags, "grpc-channels", "0"));
+    selection.http_version = GetFlag(flags, "http-version", "");
+    selection.tls = GetFlag(flags, "tls", "true") == "true";
+    selection.grpc_endpoint = GetFlag(flags, "grpc-endpoint", "");
+    selection.json_endpoint = GetFlag(flags, "json-endpoint", "");
+    if (selection.grpc_endpoint.empty() && std::getenv("CLOUD_STORAGE_EMULATOR_ENDPOINT") != nullptr) {
+        selection.grpc_endpoint = std::getenv("CLOUD_STORAGE_EMULATOR_ENDPOINT");
+        selection.grpc_emulator = !selection.grpc_endpoint.empty();
+    }
+    if (selection.json_endpoint.empty() && std::getenv("STORAGE_EMULATOR_HOST") != nullptr) {
+        selection.json_endpoint = std::getenv("STORAGE_EMULATOR_HOST");
+        if (!selection.json_endpoint.empty() && selection.json_endpoint.find("://") == std::string::npos) {
+            selection.json_endpoint = "http://" + selection.json_endpoint;
+        }
+        selection.json_emulator = !selection.json_endpoint.empty();
+    }
+    selection.ca_file = GetFlag(flags, "ca-file", "");
+    selection.access_token = GetFlag(flags, "access-token", "");
+    if (selection.access_token.empty() && std::getenv("GOOGLE_OAUTH_ACCESS_TOKEN") != nullptr) {
+        selection.access_token = std::getenv("GOOGLE_OAUTH_ACCESS_TOKEN");
+    }
+    selection.grpc_flow_control.window_size = ParseSize(GetFlag(flags, "grpc-window-size", "0"));
+    selection.grpc_flow_control.bdp_probe = GetFlag(flags, "grpc-bdp-probe", "");
+    selection.grpc_flow_control.max_receive_message_size = ParseSize(GetFlag(flags, "grpc-max-message-size", "0"));
+
+    if (selection.grpc_path != "default" && selection.grpc_path != "direct" && selection.grpc_path != "cloudpath") {
+        std::cerr << "Error: --grpc-path must be default, direct or cloudpath\n";
+        return false;
+    }
+    if (selection.grpc_security != "default" && selection.grpc_security != "alts" &&
+        selection.grpc_security != "tls") {
+        std::cerr << "Error: --grpc-security must be default, alts or tls\n";
+        return false;
+    }
+    if (!selection.http_version.empty() && selection.http_version != "1.1" && selection.http_version != "2.0") {
+        std::cerr << "Error: --http-version must be 1.1 or 2.0\n";
+        return false;
+    }
+    if (!selection.grpc_flow_control.bdp_probe.empty() && selection.grpc_flow_control.bdp_probe != "on" &&
+        selection.grpc_flow_control.bdp_probe != "off") {
+        std::cerr << "Error: --grpc-bdp-probe must be on or off\n";
+        return false;
+    }
+    if (selection.grpc_channels < 0) {
+        std::cerr << "Error: --grpc-channels must not be negative\n";
+        return false;
+    }
+    if (!selection.tls && (selection.grpc_security != "default" || selection.grpc_path == "direct")) {
+        std::cerr << "Error: --tls=false cannot be combined with --grpc-security or --grpc-path=direct\n";
+        return false;
+    }
+    std::string unused;
+    if (!selection.ca_file.empty() && !ReadFile(selection.ca_file, unused)) {
+        std::cerr << "Error: cannot read --ca-file " << selection.ca_file << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool HasTransportFlags(const BenchmarkFlags &flags) {
+    static const char *const kTransportFlags[] = {
+        "grpc-path",     "grpc-security", "grpc-channels", "http-version",     "tls",
+        "grpc-endpoint", "json-endpoint", "ca-file",       "access-token",     "grpc-window-size",
+        "grpc-bdp-probe", "grpc-max-message-size"};
+    return std::any_of(std::begin(kTransportFlags), std::end(kTransportFlags),
+                       [&](const char *name) { return flags.count(name) != 0; });
+}
+
+void SelectTransport(const TransportSelection &selection) { g_selection = selection; }
+
+const TransportSelection &SelectedTransport() { return g_selection; }
+
+std::shared_ptr<grpc::ChannelCredentials> SelectedGrpcCredentials() {
+    auto credentials = GrpcChannelCredentials(g_selection);
+    return credentials ? credentials : grpc::GoogleDefaultCredentials();
+}
+
+gcs::Client MakeJsonClient(gc::Options options) {
+    const auto &selection = g_selection;
+    if ((!selection.json_endpoint.empty() || !selection.tls) && !options.has<gcs::RestEndpointOption>()) {
+        options.set<gcs::RestEndpointOption>(selection.JsonEndpoint());
+    }
+    if (!selection.http_version.empty() && !options.has<gcs_ex::HttpVersionOption>()) {
+        options.set<gcs_ex::HttpVersionOption>(selection.http_version);
+    }
+    if (!selection.ca_file.empty() && !options.has<gc::CARootsFilePathOption>()) {
+        options.set<gc::CARootsFilePathOption>(selection.ca_file);
+    }
+    if ((!selection.tls || selection.json_emulator) && !options.has<gc::UnifiedCredentialsOption>()) {
+        options.set<gc::UnifiedCredentialsOption>(gc::MakeInsecureCredentials());
+    }
+    return gcs::Client(std::move(options));
+}
+
+gcs::Client MakeGrpcClient(gc::Options options) {
+    const auto &selection = g_selection;
+    if ((selection.grpc_path != "default" || !selection.grpc_endpoint.empty()) &&
+        !options.has<gc::EndpointOption>()) {
+        options.set<gc::EndpointOption>(selection.GrpcTarget());
+        if (selection.grpc_path == "direct") options.set<gc::AuthorityOption>("storage.googleapis.com");
+    }
+    auto credentials = GrpcChannelCredentials(selection);
+    if (credentials && !options.has<gc::GrpcCredentialOption>() && !options.has<gc::UnifiedCredentialsOption>()) {
+        options.set<gc::GrpcCredentialOption>(std::move(credentials));
+    }
+    if (selection.grpc_channels > 0 && !options.has<gc::GrpcNumChannelsOption>()) {
+        options.set<gc::GrpcNumChannelsOption>(selection.grpc_channels);
+    }
+    if (!selection.grpc_flow_control.IsDefault() && !options.has<gc::GrpcChannelArgumentsNativeOption>()) {
+        options.set<gc::GrpcChannelArgumentsNativeOption>(GrpcFlowControlArguments(selection.grpc_flow_control));
+    }
+    return gcs::MakeGrpcClient(std::move(options));
+}
+
+std::string ClassifyPeer(const std::string &peer) {
+    if (peer.compare(0, 5, "unix:") == 0) return "local";
+    auto address = peer;
+    if (address.compare(0, 5, "ipv4:") == 0 || address.compare(0, 5, "ipv6:") == 0) address = address.substr(5);
+    // Newer gRPC releases percent-encode the brackets around IPv6 addresses.
+    for (auto pos = address.find("%5B"); pos != std::string::npos; pos = address.find("%5B")) address.replace(pos, 3, "[");
+    for (auto pos = address.find("%5D"); pos != std::string::npos; pos = address.find("%5D")) address.replace(pos, 3, "]");
+    if (!address.empty() && address.front() == '[') {
+        address = address.substr(1, address.find(']') - 1);
+    } else if (address.find(':') != std::string::npos && address.find(':') == address.rfind(':')) {
+        address = address.substr(0, address.find(':'));  // a.b.c.d:port
+    }
+
+    unsigned char bytes[16];
+    if (inet_pton(AF_INET6, address.c_str(), bytes) == 1) {
+        static const unsigned char kMappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+        static const unsigned char kLoopback[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+        if (std::equal(kMappedPrefix, kMappedPrefix + 12, bytes)) {
+            std::memmove(bytes, bytes + 12, 4);
+        } else {
+            if (std::equal(kLoopback, kLoopback + 16, bytes)) return "local";
+            if ((bytes[0] & 0xfe) == 0xfc || (bytes[0] == 0xfe && (bytes[1] & 0xc0) == 0x80)) return "local";
+            // 2001:4860:8040::/42
+            if (bytes[0] == 0x20 && bytes[1] == 0x01 && bytes[2] == 0x48 && bytes[3] == 0x60 && bytes[4] == 0x80 &&
+                (bytes[5] & 0xc0) == 0x40) {
+                return "direct";
+            }
+            return "cloudpath";
+        }
+    } else if (inet_pton(AF_INET, address.c_str(), bytes) != 1) {
+        return "unknown";
+    }
+    if (bytes[0] == 127 || bytes[0] == 10 || (bytes[0] == 172 && (bytes[1] & 0xf0) == 16) ||
+        (bytes[0] == 192 && bytes[1] == 168)) {
+        return "local";
+    }
+    // 34.126.0.0/18
+    if (bytes[0] == 34 && bytes[1] == 126 && bytes[2] < 64) return "direct";
+    return "cloudpath";
+}
+
+std::vector<EffectivePath> ProbeGrpcPaths(const std::string &bucket, const std::string &object_name) {
+    const auto &selection = g_selection;
+    auto credentials = SelectedGrpcCredentials();
+
+    std::vector<EffectivePath> paths;
+    int channels = std::max(selection.grpc_channels, 1);
+    for (int i = 0; i < channels; ++i) {
+        grpc::ChannelArguments args;
+        // Separate connections per channel, as the client library's channels have.
+        args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+        args.SetInt("gcsbench.probe_channel", i);
+        if (selection.grpc_path == "direct" && selection.grpc_endpoint.empty()) {
+            args.SetString(GRPC_ARG_DEFAULT_AUTHORITY, "storage.googleapis.com");
+        }
+        auto channel = grpc::CreateCustomChannel(selection.GrpcTarget(), credentials, args);
+        auto stub = storage_v2::Storage::NewStub(channel);
+
+        storage_v2::GetObjectRequest request;
+        request.set_bucket("projects/_/buckets/" + bucket);
+        request.set_object(object_name);
+        grpc::ClientContext context;
+        context.set_deadline(std::chrono::system_clock::now() + kProbeTimeout);
+        context.AddMetadata("x-goog-request-params", RoutingBucketParam(bucket));
+        storage_v2::Object object;
+        auto status = stub->GetObject(&context, request, &object);
+
+        EffectivePath path;
+        path.peer = context.peer();
+        path.path = path.peer.empty() ? "unknown" : ClassifyPeer(path.peer);
+        path.security = "unknown";
+        if (auto auth = context.auth_context()) {
+            auto values = auth->FindPropertyValues(GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME);
+            if (!values.empty()) {
+                std::string type(values.front().data(), values.front().size());
+                path.security = type == "ssl" ? "tls" : type;
+            }
+        }
+        path.protocol = channel->GetLoadBalancingPolicyName();
+        if (!status.ok()) path.error = status.error_message();
+        paths.push_back(std::move(path));
+    }
+    return paths;
+}
+
+EffectivePath ProbeJsonPath(const std::string &bucket, const std::string &object_name) {
+    const auto &selection = g_selection;
+    auto endpoint = selection.JsonEndpoint();
+    auto url = endpoint + "/storage/v1/b/" + UriEncode(bucket, false) + "/o/" + UriEncode(object_name, false) +
+               "?fields=size";
+
+    EffectivePath path;
+    path.path = "unknown";
+    path.security = endpoint.compare(0, 8, "https://") == 0 ? "tls" : "insecure";
+    CURL *curl = curl_easy_init();
+    if (curl == nullptr) {
+        path.error = "curl_easy_init failed";
+        return path;
+    }
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, DiscardBody);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(
+                                                   std::chrono::milliseconds(kProbeTimeout).count()));
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    if (selection.http_version == "1.1") curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
+    if (selection.http_version == "2.0") curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_0);
+    if (!selection.ca_file.empty()) curl_easy_setopt(curl, CURLOPT_CAINFO, selection.ca_file.c_str());
+
+    auto code = curl_easy_perform(curl);
+    if (code != CURLE_OK) path.error = curl_easy_strerror(code);
+    char *ip = nullptr;
+    long port = 0;
+    long version = 0;
+    curl_easy_getinfo(curl, CURLINFO_PRIMARY_IP, &ip);
+    curl_easy_getinfo(curl, CURLINFO_PRIMARY_PORT, &port);
+    curl_easy_getinfo(curl, CURLINFO_HTTP_VERSION, &version);
+    if (ip != nullptr && *ip != '\0') {
+        std::string address = ip;
+        path.peer = (address.find(':') != std::string::npos ? "[" + address + "]" : address) + ":" +
+                    std::to_string(port);
+        path.path = ClassifyPeer(address);
+    }
+    switch (version) {
+    case CURL_HTTP_VERSION_1_0:
+        path.protocol = "http/1.0";
+        break;
+    case CURL_HTTP_VERSION_1_1:
+        path.protocol = "http/1.1";
+        break;
+    case CURL_HTTP_VERSION_2_0:
+        path.protocol = "http/2";
+        break;
+    case CURL_HTTP_VERSION_3:
+        path.protocol = "http/3";
+        break;
+    default:
+        path.protocol = "unknown";
+    }
+    curl_easy_cleanup(curl);
+    return path;
+}
+
+void DetectEffectivePaths(const std::string &bucket, const std::string &object_name) {
+    const auto &selection = g_selection;
+    auto grpc_paths = ProbeGrpcPaths(bucket, object_name);
+    auto json_path = ProbeJsonPath(bucket, object_name);
+
+    std::cout << "\n==== Effective Transport (" << selection.Label() << ") ====\n";
+    std::cout << "gRPC target " << selection.GrpcTarget() << ", JSON endpoint " << selection.JsonEndpoint() << "\n";
+    std::cout << std::left << std::setw(14) << "Channel" << std::setw(11) << "Path" << std::setw(10) << "Security"
+              << std::setw(44) << "Peer" << "Protocol\n";
+    auto print = [](const std::string &name, const EffectivePath &path) {
+        std::cout << std::setw(14) << name << std::setw(11) << path.path << std::setw(10) << path.security
+                  << std::setw(44) << (path.peer.empty() ? "-" : path.peer) << path.protocol;
+        if (!path.error.empty()) std::cout << "  (probe: " << path.error << ")";
+        std::cout << "\n";
+    };
+    for (std::size_t i = 0; i < grpc_paths.size(); ++i) {
+        print("grpc " + std::to_string(i), grpc_paths[i]);
+    }
+    print("json", json_path);
+    std::cout << std::right;
+
+    auto off_path = std::count_if(grpc_paths.begin(), grpc_paths.end(),
+                                  [](const EffectivePath &path) { return path.path != "direct"; });
+    if (selection.grpc_path == "direct" && off_path > 0) {
+        std::cout << "Warning: direct path requested, but " << off_path << " of " << grpc_paths.size()
+                  << " gRPC channels did not reach a direct-path address\n";
+    }
+
+    g_grpc_path_label = "gRPC " + Summarize(grpc_paths);
+    g_json_path_label = "JSON " + json_path.path + "/" + json_path.security + " " + json_path.protocol +
+                        (json_path.peer.empty() ? "" : " (" + json_path.peer + ")");
+}
+
+std::string EffectivePathLabel(const std::string &type) {
+    auto name = Lower(type);
+    // The raw readers have their own endpoints and channels.
+    if (name.find("raw") != std::string::npos) return {};
+    if (name.find("grpc") != std::string::npos) return g_grpc_path_label;
+    if (name.find("json") != std::string::npos) return g_json_path_label;
+    return {};
+}
+
+}  // namespace gcsbench
@@ -0,0 +1,124 @@
+#ifndef GCSBENCH_TRANSPORT_H
+#define GCSBENCH_TRANSPORT_H
+
+#include "gcsbench/common.h"
+#include "gcsbench/flags.h"
+
+#include <grpcpp/security/credentials.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gcsbench {
+
+// gRPC HTTP/2 flow-control channel arguments; zero or empty keeps gRPC's
+// default. The window is the initial stream window the client advertises
+// (GRPC_ARG_HTTP2_STREAM_LOOKAHEAD_BYTES). BDP probing resizes the windows
+// from measured bandwidth-delay product, so a window only stays fixed with
+// the probe off.
+struct GrpcTransportConfig {
+    std::size_t window_size = 0;
+    std::string bdp_probe;  // on, off or empty
+    std::size_t max_receive_message_size = 0;
+
+    bool IsDefault() const { return window_size == 0 && bdp_probe.empty() && max_receive_message_size == 0; }
+
+    std::string Label() const {
+        return "window=" + (window_size == 0 ? std::string("default") : FormatSize(window_size)) +
+               " bdp=" + (bdp_probe.empty() ? std::string("default") : bdp_probe) + " maxmsg=" +
+               (max_receive_message_size == 0 ? std::string("default") : FormatSize(max_receive_message_size));
+    }
+};
+
+// Which network path the client libraries are asked to take, from the
+// transport flags (see README):
+//   --grpc-path=default|direct|cloudpath   google-c2p:/// vs dns:/// target
+//   --grpc-security=default|alts|tls       channel credentials when --tls=true
+//   --grpc-channels=N                      gRPC channels per client
+//   --http-version=1.1|2.0                 JSON client HTTP version
+//   --tls=true|false                       false: plaintext, no credentials
+//   --grpc-endpoint, --json-endpoint       override the targets (emulators)
+//   --ca-file                              trust a local TLS stand-in
+//   --grpc-window-size, --grpc-bdp-probe,  gRPC HTTP/2 flow control
+//   --grpc-max-message-size
+// Without an endpoint flag, CLOUD_STORAGE_EMULATOR_ENDPOINT (gRPC) and
+// STORAGE_EMULATOR_HOST (JSON) select a plaintext, unauthenticated emulator.
+struct TransportSelection {
+    std::string grpc_path = "default";
+    std::string grpc_security = "default";
+    int grpc_channels = 0;  // 0 keeps the library default
+    std::string http_version;
+    bool tls = true;
+    std::string grpc_endpoint;
+    std::string json_endpoint;
+    bool grpc_emulator = false;  // grpc_endpoint came from the environment
+    bool json_emulator = false;  // json_endpoint came from the environment
+    std::string ca_file;
+    std::string access_token;  // call credentials for --grpc-security=tls
+    GrpcTransportConfig grpc_flow_control;
+
+    std::string GrpcTarget() const;
+    std::string JsonEndpoint() const;
+    std::string Label() const;
+};
+
+// Returns false (after logging) for an invalid combination.
+bool ParseTransportSelection(const BenchmarkFlags &flags, TransportSelection &selection);
+
+// Whether any of the transport flags above was given; the effective-path
+// probes only run by default when one was.
+bool HasTransportFlags(const BenchmarkFlags &flags);
+
+// Makes `selection` the transport of every client built by MakeJsonClient and
+// MakeGrpcClient. Called once by the CLI before any client exists.
+void SelectTransport(const TransportSelection &selection);
+
+const TransportSelection &SelectedTransport();
+
+// The selected gRPC client's channel credentials, or the application default
+// credentials where the client keeps the library default. For channels built
+// outside the library (the probes, the raw stub reader).
+std::shared_ptr<grpc::ChannelCredentials> SelectedGrpcCredentials();
+
+// The client libraries with the selected transport. Options already set in
+// `options` take precedence over the selection.
+gcs::Client MakeJsonClient(gc::Options options = {});
+gcs::Client MakeGrpcClient(gc::Options options = {});
+
+// Where a connection actually went.
+struct EffectivePath {
+    std::string peer;      // e.g. ipv6:[2001:4860:8040::1]:443
+    std::string path;      // direct, cloudpath, local or unknown
+    std::string security;  // alts, tls or insecure
+    std::string protocol;  // lb policy for gRPC, HTTP version for JSON
+    std::string error;     // why the probe failed, if it did
+};
+
+// Classifies a gRPC peer string or a plain IP address: direct-path VIPs
+// (2001:4860:8040::/42, 34.126.0.0/18), loopback and private addresses
+// (local), anything else (cloudpath).
+std::string ClassifyPeer(const std::string &peer);
+
+// Opens one probe channel per --grpc-channels (one if unset) with the
+// selected target (emulator included) and credentials, each on its own subchannel pool as the
+// library's channels are, and issues a GetObject on each to learn the peer
+// and negotiated security.
+std::vector<EffectivePath> ProbeGrpcPaths(const std::string &bucket, const std::string &object_name);
+
+// One libcurl request to the selected JSON endpoint (emulator included) with the selected HTTP
+// version and CA file; no credentials are sent, so any HTTP status will do.
+EffectivePath ProbeJsonPath(const std::string &bucket, const std::string &object_name);
+
+// Probes both clients, prints the per-channel paths, and remembers a summary
+// that result headers carry from then on.
+void DetectEffectivePaths(const std::string &bucket, const std::string &object_name);
+
+// The effective-path summary for results tagged `type` (by whether it names
+// the gRPC or JSON client), or empty if nothing was detected.
+std::string EffectivePathLabel(const std::string &type);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_TRANSPORT_H
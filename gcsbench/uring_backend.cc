@@ -0,0 +1,675 @@
+#include "gcsbench/uring_backend.h"
+
+#include <iostream>
+
+#ifdef GCS_BENCHMARK_HAVE_LIBURING
+#include "gcsbench/http_backends.h"
+
+#include <liburing.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#endif
+
+namespace gcsbench {
+
+#ifdef GCS_BENCHMARK_HAVE_LIBURING
+
+namespace {
+
+constexpr std::size_t kRequestBufferSize = 4 * kKiB;
+constexpr std::size_t kMaxHeaderSize = 16 * kKiB;
+constexpr int kBufferGroup = 0;
+
+// user_data of every submission: the operation in the high half, the
+// connection in the low half.
+enum Operation : uint64_t { kWake = 1, kSend = 2, kReceive = 3 };
+
+uint64_t Tag(Operation op, std::size_t connection) {
+    return (static_cast<uint64_t>(op) << 32) | connection;
+}
+
+struct UringRequest {
+    std::string target;  // request-target, e.g. /storage/v1/b/...?alt=media
+    std::string range;   // "bytes=a-b", empty for the whole object
+    char *destination = nullptr;  // nullptr consumes the body in the receive buffers
+    std::size_t capacity = 0;
+    std::size_t received = 0;
+    bool done = false;
+    bool ok = false;
+    std::string error;
+};
+
+struct Connection {
+    int fd = -1;
+    bool receiving = false;  // a multishot receive is armed or still draining
+    UringRequest *request = nullptr;
+    std::size_t send_offset = 0;
+    std::size_t send_length = 0;
+    std::string header;
+    bool in_body = false;
+    int status = 0;
+    bool has_length = false;
+    std::size_t content_length = 0;
+    std::size_t body_received = 0;
+    bool close_after = false;
+};
+
+bool StartsWithNoCase(const std::string &line, const char *prefix) {
+    auto n = std::strlen(prefix);
+    if (line.size() < n) return false;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::tolower(static_cast<unsigned char>(line[i])) != prefix[i]) return false;
+    }
+    return true;
+}
+
+class UringBackend : public StorageBackend {
+public:
+    UringBackend(std::string host, std::string port, std::size_t connections, unsigned buffer_count,
+                 std::size_t buffer_size)
+        : host_(std::move(host)),
+          port_(std::move(port)),
+          connections_(connections),
+          buffer_count_(buffer_count),
+          buffer_size_(buffer_size) {}
+
+    ~UringBackend() override {
+        if (loop_.joinable()) {
+            bool running;
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                stop_ = true;
+                running = !failed_;
+            }
+            if (running) Wake();
+            loop_.join();
+        }
+        // Closed only here, so a Wake() racing with the loop's exit still
+        // writes to a valid eventfd.
+        if (wake_fd_ >= 0) close(wake_fd_);
+    }
+
+    UringBackend(const UringBackend &) = delete;
+    UringBackend &operator=(const UringBackend &) = delete;
+
+    // Sets up the ring on the loop thread, which then owns it. Returns false
+    // (after logging) if the kernel or endpoint are not usable.
+    bool Start() {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo *addresses = nullptr;
+        if (int rc = getaddrinfo(host_.c_str(), port_.c_str(), &hints, &addresses); rc != 0) {
+            std::cerr << "Error: cannot resolve " << host_ << ": " << gai_strerror(rc) << "\n";
+            return false;
+        }
+        std::memcpy(&address_, addresses->ai_addr, addresses->ai_addrlen);
+        address_length_ = addresses->ai_addrlen;
+        address_family_ = addresses->ai_family;
+        freeaddrinfo(addresses);
+
+        wake_fd_ = eventfd(0, EFD_CLOEXEC);
+        if (wake_fd_ < 0) {
+            std::cerr << "Error: eventfd: " << std::strerror(errno) << "\n";
+            return false;
+        }
+        std::promise<std::string> started;
+        auto result = started.get_future();
+        loop_ = std::thread([this, &started] { Loop(started); });
+        auto error = result.get();
+        if (!error.empty()) {
+            std::cerr << "Error: io_uring setup failed: " << error << "\n";
+            loop_.join();
+            return false;
+        }
+        return true;
+    }
+
+    std::string Name() const override { return "uring"; }
+
+    bool ObjectSize(const std::string &bucket, const std::string &object_name, std::size_t &size) override {
+        std::vector<char> body(4 * kKiB);
+        UringRequest request;
+        request.target = ObjectPath(bucket, object_name) + "?fields=size";
+        request.destination = body.data();
+        request.capacity = body.size();
+        if (!Submit(request)) return false;
+        std::string json(body.data(), request.received);
+        if (!ParseObjectSize(json, size)) {
+            std::cerr << "Error: no size in object metadata for " << bucket << "/" << object_name << ": " << json
+                      << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool ReadObject(const std::string &bucket,
+                    const std::string &object_name,
+                    std::size_t,
+                    std::size_t &bytes_read) override {
+        UringRequest request;
+        request.target = ObjectPath(bucket, object_name) + "?alt=media";
+        bool ok = Submit(request);
+        bytes_read = request.received;
+        return ok;
+    }
+
+    bool ReadRange(const std::string &bucket,
+                   const std::string &object_name,
+                   std::size_t offset,
+                   std::size_t length,
+                   char *buffer,
+                   std::size_t &bytes_read) override {
+        UringRequest request;
+        request.target = ObjectPath(bucket, object_name) + "?alt=media";
+        request.range = "bytes=" + std::to_string(offset) + "-" + std::to_string(offset + length - 1);
+        request.destination = buffer;
+        request.capacity = length;
+        bool ok = Submit(request);
+        bytes_read = request.received;
+        return ok;
+    }
+
+    void PrintTransportStats() const override {
+        auto requests = completed_.load();
+        auto enters = enter_calls_.load();
+        std::cout << "    io_uring: " << requests << " requests, " << enters << " io_uring_enter calls ("
+                  << (requests > 0 ? static_cast<double>(enters) / requests : 0.0) << " per request), "
+                  << completions_.load() << " completions, " << connects_.load() << " connections opened\n";
+    }
+
+private:
+    static std::string ObjectPath(const std::string &bucket, const std::string &object_name) {
+        return "/storage/v1/b/" + UriEncode(bucket, false) + "/o/" + UriEncode(object_name, false);
+    }
+
+    void Wake() {
+        uint64_t one = 1;
+        if (write(wake_fd_, &one, sizeof(one)) < 0) {
+            std::cerr << "Error: cannot wake the io_uring loop: " << std::strerror(errno) << "\n";
+        }
+    }
+
+    bool Submit(UringRequest &request) {
+        g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (failed_) {
+                std::cerr << "Error: uring GET " << request.target << ": io_uring loop stopped\n";
+                return false;
+            }
+            pending_.push_back(&request);
+        }
+        Wake();
+        {
+            std::unique_lock<std::mutex> lock(mu_);
+            done_cv_.wait(lock, [&] { return request.done; });
+        }
+        if (!request.ok) {
+            std::cerr << "Error: uring GET " << request.target << ": " << request.error << "\n";
+        }
+        return request.ok;
+    }
+
+    io_uring_sqe *GetSqe() {
+        auto *sqe = io_uring_get_sqe(&ring_);
+        if (sqe == nullptr) {
+            // The submission queue is full: flush it and try again.
+            io_uring_submit(&ring_);
+            ++enter_calls_;
+            sqe = io_uring_get_sqe(&ring_);
+        }
+        return sqe;
+    }
+
+    std::string Setup() {
+        io_uring_params params{};
+        // The loop thread is the only submitter, so completions can wait for it.
+        params.flags = IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+        auto entries = static_cast<unsigned>(std::max<std::size_t>(2 * connections_ + 8, 64));
+        int rc = io_uring_queue_init_params(entries, &ring_, &params);
+        if (rc == -EINVAL) {
+            params = io_uring_params{};
+            rc = io_uring_queue_init_params(entries, &ring_, &params);
+        }
+        if (rc < 0) return std::string("io_uring_queue_init: ") + std::strerror(-rc);
+        ring_initialized_ = true;
+
+        rc = io_uring_register_files_sparse(&ring_, static_cast<unsigned>(connections_));
+        if (rc < 0) return std::string("io_uring_register_files_sparse: ") + std::strerror(-rc);
+
+        // One registered buffer per connection holds its request headers.
+        request_buffers_.resize(connections_ * kRequestBufferSize);
+        std::vector<iovec> iovecs(connections_);
+        for (std::size_t i = 0; i < connections_; ++i) {
+            iovecs[i].iov_base = request_buffers_.data() + i * kRequestBufferSize;
+            iovecs[i].iov_len = kRequestBufferSize;
+        }
+        rc = io_uring_register_buffers(&ring_, iovecs.data(), static_cast<unsigned>(iovecs.size()));
+        if (rc < 0) return std::string("io_uring_register_buffers: ") + std::strerror(-rc);
+
+        // Provided buffer ring the multishot receives pick their buffers from.
+        receive_buffers_.resize(static_cast<std::size_t>(buffer_count_) * buffer_size_);
+        buffer_ring_ = io_uring_setup_buf_ring(&ring_, buffer_count_, kBufferGroup, 0, &rc);
+        if (buffer_ring_ == nullptr) return std::string("io_uring_setup_buf_ring: ") + std::strerror(-rc);
+        for (unsigned i = 0; i < buffer_count_; ++i) {
+            io_uring_buf_ring_add(buffer_ring_, receive_buffers_.data() + i * buffer_size_,
+                                  static_cast<unsigned>(buffer_size_), static_cast<unsigned short>(i),
+                                  io_uring_buf_ring_mask(buffer_count_), static_cast<int>(i));
+        }
+        io_uring_buf_ring_advance(buffer_ring_, static_cast<int>(buffer_count_));
+
+        connection_state_.resize(connections_);
+        ArmWake();
+        return {};
+    }
+
+    void Teardown() {
+        for (std::size_t i = 0; i < connection_state_.size(); ++i) {
+            if (connection_state_[i].fd >= 0) close(connection_state_[i].fd);
+        }
+        if (ring_initialized_) {
+            if (buffer_ring_ != nullptr) io_uring_free_buf_ring(&ring_, buffer_ring_, buffer_count_, kBufferGroup);
+            io_uring_queue_exit(&ring_);
+        }
+    }
+
+    void ArmWake() {
+        auto *sqe = GetSqe();
+        io_uring_prep_read(sqe, wake_fd_, &wake_value_, sizeof(wake_value_), 0);
+        io_uring_sqe_set_data64(sqe, Tag(kWake, 0));
+    }
+
+    void ArmReceive(std::size_t index) {
+        auto *sqe = GetSqe();
+        io_uring_prep_recv_multishot(sqe, static_cast<int>(index), nullptr, 0, 0);
+        sqe->flags |= IOSQE_FIXED_FILE | IOSQE_BUFFER_SELECT;
+        sqe->buf_group = kBufferGroup;
+        io_uring_sqe_set_data64(sqe, Tag(kReceive, index));
+        connection_state_[index].receiving = true;
+    }
+
+    void SubmitSend(std::size_t index) {
+        auto &connection = connection_state_[index];
+        auto *sqe = GetSqe();
+        io_uring_prep_write_fixed(sqe, static_cast<int>(index),
+                                  request_buffers_.data() + index * kRequestBufferSize + connection.send_offset,
+                                  static_cast<unsigned>(connection.send_length - connection.send_offset), 0,
+                                  static_cast<int>(index));
+        sqe->flags |= IOSQE_FIXED_FILE;
+        io_uring_sqe_set_data64(sqe, Tag(kSend, index));
+    }
+
+    bool Connect(std::size_t index) {
+        int fd = socket(address_family_, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return false;
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        if (connect(fd, reinterpret_cast<sockaddr *>(&address_), address_length_) != 0 ||
+            io_uring_register_files_update(&ring_, static_cast<unsigned>(index), &fd, 1) < 0) {
+            close(fd);
+            return false;
+        }
+        connection_state_[index].fd = fd;
+        ++connects_;
+        return true;
+    }
+
+    void CloseConnection(std::size_t index) {
+        auto &connection = connection_state_[index];
+        if (connection.fd < 0) return;
+        // Ends the armed receive; the slot is reusable once its last completion arrives.
+        shutdown(connection.fd, SHUT_RDWR);
+        int removed = -1;
+        io_uring_register_files_update(&ring_, static_cast<unsigned>(index), &removed, 1);
+        close(connection.fd);
+        connection.fd = -1;
+    }
+
+    void Complete(std::size_t index, bool ok, const std::string &error) {
+        auto &connection = connection_state_[index];
+        auto *request = connection.request;
+        connection.request = nullptr;
+        if (request == nullptr) return;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (ok && connection.status >= 300) {
+                // The error body was collected in request->error.
+                ok = false;
+                auto body = std::move(request->error);
+                request->error = "HTTP " + std::to_string(connection.status) + (body.empty() ? "" : ": " + body);
+            } else if (!ok) {
+                request->error = error;
+            }
+            request->ok = ok;
+            request->done = true;
+        }
+        done_cv_.notify_all();
+        ++completed_;
+        if (!ok || connection.close_after) CloseConnection(index);
+    }
+
+    // Starts a queued request on every idle connection, opening connections
+    // up to the limit as needed.
+    void Dispatch() {
+        for (std::size_t index = 0; index < connection_state_.size() && !backlog_.empty(); ++index) {
+            auto &connection = connection_state_[index];
+            if (connection.request != nullptr) continue;
+            if (connection.fd < 0) {
+                if (connection.receiving) continue;  // previous socket still draining
+                if (!Connect(index)) {
+                    auto *request = backlog_.front();
+                    backlog_.pop_front();
+                    connection.request = request;
+                    Complete(index, false, "cannot connect to " + host_ + ":" + port_ + ": " + std::strerror(errno));
+                    continue;
+                }
+            }
+            auto *request = backlog_.front();
+            backlog_.pop_front();
+            std::string head = "GET " + request->target + " HTTP/1.1\r\nHost: " + host_ + ":" + port_ + "\r\n";
+            if (!request->range.empty()) head += "Range: " + request->range + "\r\n";
+            head += "\r\n";
+            int fd = connection.fd;
+            bool receiving = connection.receiving;
+            connection = Connection{};
+            connection.fd = fd;
+            connection.receiving = receiving;
+            connection.request = request;
+            if (head.size() > kRequestBufferSize) {
+                Complete(index, false, "request headers too long");
+                continue;
+            }
+            std::memcpy(request_buffers_.data() + index * kRequestBufferSize, head.data(), head.size());
+            connection.send_length = head.size();
+            SubmitSend(index);
+            if (!connection.receiving) ArmReceive(index);
+        }
+    }
+
+    // Parses the status line and headers; returns false on a response this
+    // reader cannot handle.
+    bool ParseHeader(Connection &connection, std::string &error) {
+        auto end = connection.header.find("\r\n\r\n");
+        std::size_t start = 0;
+        for (std::size_t line_end; start < end; start = line_end + 2) {
+            line_end = connection.header.find("\r\n", start);
+            auto line = connection.header.substr(start, line_end - start);
+            if (start == 0) {
+                auto space = line.find(' ');
+                connection.status = space == std::string::npos ? 0 : std::atoi(line.c_str() + space + 1);
+            } else if (StartsWithNoCase(line, "content-length:")) {
+                connection.has_length = true;
+                connection.content_length = std::strtoull(line.c_str() + 15, nullptr, 10);
+            } else if (StartsWithNoCase(line, "transfer-encoding:") && line.find("chunked") != std::string::npos) {
+                error = "chunked responses are not supported";
+                return false;
+            } else if (StartsWithNoCase(line, "connection:") && line.find("close") != std::string::npos) {
+                connection.close_after = true;
+            }
+        }
+        if (connection.status == 0) {
+            error = "malformed status line";
+            return false;
+        }
+        // Without a length the body ends when the server closes the connection.
+        if (!connection.has_length) connection.close_after = true;
+        return true;
+    }
+
+    void OnBody(std::size_t index, const char *data, std::size_t size) {
+        auto &connection = connection_state_[index];
+        auto *request = connection.request;
+        connection.body_received += size;
+        if (connection.status >= 300) {
+            request->error.append(data, std::min<std::size_t>(size, 1024));
+        } else {
+            if (request->destination != nullptr) {
+                if (request->received + size > request->capacity) {
+                    Complete(index, false, "response larger than the " + std::to_string(request->capacity) +
+                                               " bytes requested");
+                    return;
+                }
+                std::memcpy(request->destination + request->received, data, size);
+            }
+            request->received += size;
+            g_progress.bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+        if (connection.has_length && connection.body_received >= connection.content_length) {
+            Complete(index, true, {});
+        }
+    }
+
+    void OnData(std::size_t index, const char *data, std::size_t size) {
+        auto &connection = connection_state_[index];
+        if (connection.request == nullptr) {
+            CloseConnection(index);  // bytes nobody asked for
+            return;
+        }
+        if (connection.in_body) {
+            OnBody(index, data, size);
+            return;
+        }
+        auto scanned = connection.header.size() < 3 ? 0 : connection.header.size() - 3;
+        connection.header.append(data, size);
+        auto end = connection.header.find("\r\n\r\n", scanned);
+        if (end == std::string::npos) {
+            if (connection.header.size() > kMaxHeaderSize) Complete(index, false, "response headers too long");
+            return;
+        }
+        std::string error;
+        if (!ParseHeader(connection, error)) {
+            Complete(index, false, error);
+            return;
+        }
+        connection.in_body = true;
+        auto body_start = end + 4;
+        auto rest = connection.header.size() - body_start;
+        if (rest > 0 || (connection.has_length && connection.content_length == 0)) {
+            std::string body = connection.header.substr(body_start);
+            OnBody(index, body.data(), body.size());
+        }
+    }
+
+    void OnReceive(std::size_t index, io_uring_cqe *cqe) {
+        auto &connection = connection_state_[index];
+        if (!(cqe->flags & IORING_CQE_F_MORE)) connection.receiving = false;
+        if (cqe->res > 0 && (cqe->flags & IORING_CQE_F_BUFFER)) {
+            auto buffer_id = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+            auto *data = receive_buffers_.data() + static_cast<std::size_t>(buffer_id) * buffer_size_;
+            if (connection.fd >= 0) OnData(index, data, static_cast<std::size_t>(cqe->res));
+            io_uring_buf_ring_add(buffer_ring_, data, static_cast<unsigned>(buffer_size_),
+                                  static_cast<unsigned short>(buffer_id), io_uring_buf_ring_mask(buffer_count_), 0);
+            io_uring_buf_ring_advance(buffer_ring_, 1);
+        } else if (cqe->res == 0) {
+            // Orderly close: completes a body delimited by the close, fails anything else.
+            if (connection.request != nullptr) {
+                bool delimited = connection.in_body && !connection.has_length;
+                Complete(index, delimited, "connection closed by the server");
+            }
+            CloseConnection(index);
+        } else if (cqe->res < 0 && cqe->res != -ENOBUFS) {
+            if (connection.request != nullptr) {
+                Complete(index, false, std::string("receive failed: ") + std::strerror(-cqe->res));
+            }
+            CloseConnection(index);
+        }
+        // Out of buffers or done with a batch: re-arm while the socket is open.
+        if (!connection.receiving && connection.fd >= 0) ArmReceive(index);
+    }
+
+    void OnSend(std::size_t index, io_uring_cqe *cqe) {
+        auto &connection = connection_state_[index];
+        if (connection.request == nullptr) return;
+        if (cqe->res < 0) {
+            Complete(index, false, std::string("send failed: ") + std::strerror(-cqe->res));
+            return;
+        }
+        connection.send_offset += static_cast<std::size_t>(cqe->res);
+        if (connection.send_offset < connection.send_length) SubmitSend(index);
+    }
+
+    void Loop(std::promise<std::string> &started) {
+        auto error = Setup();
+        started.set_value(error);
+        if (!error.empty()) {
+            Teardown();
+            return;
+        }
+
+        bool stopping = false;
+        while (!stopping) {
+            int rc = io_uring_submit_and_wait(&ring_, 1);
+            ++enter_calls_;
+            if (rc < 0 && rc != -EINTR) {
+                std::cerr << "Error: io_uring_submit_and_wait: " << std::strerror(-rc) << "\n";
+                break;
+            }
+            unsigned head;
+            unsigned seen = 0;
+            io_uring_cqe *cqe;
+            io_uring_for_each_cqe(&ring_, head, cqe) {
+                ++seen;
+                auto tag = io_uring_cqe_get_data64(cqe);
+                auto index = static_cast<std::size_t>(tag & 0xFFFFFFFF);
+                switch (static_cast<Operation>(tag >> 32)) {
+                case kWake: {
+                    std::lock_guard<std::mutex> lock(mu_);
+                    stopping = stop_;
+                    backlog_.insert(backlog_.end(), pending_.begin(), pending_.end());
+                    pending_.clear();
+                    break;
+                }
+                case kSend:
+                    OnSend(index, cqe);
+                    break;
+                case kReceive:
+                    OnReceive(index, cqe);
+                    break;
+                }
+                if (static_cast<Operation>(tag >> 32) == kWake && !stopping) ArmWake();
+            }
+            io_uring_cq_advance(&ring_, seen);
+            completions_ += seen;
+            Dispatch();
+        }
+
+        // Fail whatever is still queued so no caller waits forever, and any
+        // later Submit() without queueing.
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            failed_ = true;
+            backlog_.insert(backlog_.end(), pending_.begin(), pending_.end());
+            pending_.clear();
+            for (auto *request : backlog_) {
+                request->error = "io_uring loop stopped";
+                request->done = true;
+            }
+            for (auto &connection : connection_state_) {
+                if (connection.request == nullptr) continue;
+                connection.request->error = "io_uring loop stopped";
+                connection.request->done = true;
+            }
+        }
+        done_cv_.notify_all();
+        Teardown();
+    }
+
+    std::string host_;
+    std::string port_;
+    std::size_t connections_;
+    unsigned buffer_count_;
+    std::size_t buffer_size_;
+
+    sockaddr_storage address_{};
+    socklen_t address_length_ = 0;
+    int address_family_ = AF_INET;
+    int wake_fd_ = -1;
+    uint64_t wake_value_ = 0;
+
+    // Owned by the loop thread.
+    io_uring ring_{};
+    bool ring_initialized_ = false;
+    io_uring_buf_ring *buffer_ring_ = nullptr;
+    std::vector<char> request_buffers_;
+    std::vector<char> receive_buffers_;
+    std::vector<Connection> connection_state_;
+    std::deque<UringRequest *> backlog_;
+
+    std::mutex mu_;
+    std::condition_variable done_cv_;
+    std::vector<UringRequest *> pending_;
+    bool stop_ = false;
+    bool failed_ = false;  // the loop has exited
+    std::thread loop_;
+
+    std::atomic<uint64_t> enter_calls_{0};
+    std::atomic<uint64_t> completions_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> connects_{0};
+};
+
+}  // namespace
+
+std::unique_ptr<StorageBackend> MakeUringBackend(const BenchmarkFlags &flags) {
+    const char *emulator = std::getenv("STORAGE_EMULATOR_HOST");
+    auto endpoint = GetFlag(flags, "uring-endpoint", emulator == nullptr ? "" : emulator);
+    if (endpoint.compare(0, 7, "http://") == 0) endpoint = endpoint.substr(7);
+    while (!endpoint.empty() && endpoint.back() == '/') endpoint.pop_back();
+    if (endpoint.empty() || endpoint.find("://") != std::string::npos) {
+        std::cerr << "Error: the uring backend needs a plain HTTP --uring-endpoint=host:port (or "
+                     "STORAGE_EMULATOR_HOST)\n";
+        return nullptr;
+    }
+    auto colon = endpoint.rfind(':');
+    auto host = colon == std::string::npos ? endpoint : endpoint.substr(0, colon);
+    auto port = colon == std::string::npos ? std::string("80") : endpoint.substr(colon + 1);
+
+    auto connections = std::stoul(GetFlag(flags, "uring-connections", "64"));
+    auto buffer_size = ParseSize(GetFlag(flags, "uring-buffer-size", "64KiB"));
+    // Buffer rings hold a power-of-two number of entries.
+    auto requested_buffers = std::stoul(GetFlag(flags, "uring-buffers", "256"));
+    if (connections == 0 || buffer_size == 0 || requested_buffers > 32768) {
+        std::cerr << "Error: --uring-connections and --uring-buffer-size must be positive and "
+                     "--uring-buffers at most 32768\n";
+        return nullptr;
+    }
+    unsigned buffer_count = 1;
+    while (buffer_count < requested_buffers) buffer_count <<= 1;
+
+    auto backend = std::make_unique<UringBackend>(host, port, connections, buffer_count, buffer_size);
+    if (!backend->Start()) return nullptr;
+    return backend;
+}
+
+#else
+
+std::unique_ptr<StorageBackend> MakeUringBackend(const BenchmarkFlags &) {
+    std::cerr << "Error: the uring backend requires building with liburing 2.4 or newer\n";
+    return nullptr;
+}
+
+#endif  // GCS_BENCHMARK_HAVE_LIBURING
+
+}  // namespace gcsbench
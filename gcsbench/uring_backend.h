@@ -0,0 +1,24 @@
+#ifndef GCSBENCH_URING_BACKEND_H
+#define GCSBENCH_URING_BACKEND_H
+
+#include "gcsbench/backends.h"
+#include "gcsbench/flags.h"
+
+#include <memory>
+
+namespace gcsbench {
+
+// Experimental: JSON API range GETs over plain HTTP/1.1 keep-alive
+// connections driven by one io_uring on a dedicated thread, for measuring
+// what per-request syscalls cost the curl-based transport. Requests are
+// written from registered buffers, and every connection keeps a multishot
+// receive armed that fills buffers from a provided buffer ring, so one
+// io_uring_enter covers the sends and receives of all connections in flight.
+// Targets the emulator (--uring-endpoint, defaulting to
+// STORAGE_EMULATOR_HOST), since it does not speak TLS. Requires building with
+// liburing; returns nullptr (after logging) otherwise.
+std::unique_ptr<StorageBackend> MakeUringBackend(const BenchmarkFlags &flags);
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_URING_BACKEND_H
@@ -0,0 +1,501 @@
+#include "gcsbench/workloads.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace gcsbench {
+
+namespace {
+
+// Fills `buffer` with up to `length` bytes in kProgressChunkSize pieces,
+// publishing each to g_progress. The stream still fetches with its own
+// download buffer; only how often progress is reported changes. Stops early
+// at the end of the stream or on an error, which the caller checks.
+std::size_t ReadWithProgress(gcs::ObjectReadStream &stream, char *buffer, std::size_t length) {
+    std::size_t total = 0;
+    while (total < length) {
+        stream.read(buffer + total, std::min(length - total, kProgressChunkSize));
+        auto n = static_cast<std::size_t>(stream.gcount());
+        total += n;
+        g_progress.bytes.fetch_add(n, std::memory_order_relaxed);
+        if (!stream) break;
+    }
+    return total;
+}
+
+}  // namespace
+
+BenchmarkResult SequentialReadBenchmark(gcs::Client &client,
+                                        const std::string &bucket,
+                                        const std::string &object_name,
+                                        size_t buffer_size,
+                                        const ReadOptions &read_options) {
+    BenchmarkResult result;
+    auto start_time = BenchmarkClock::now();
+
+    // A default-constructed option has no value and is not sent, so the
+    // default ReadOptions read exactly as ReadObject(bucket, object_name).
+    auto stream = client.ReadObject(
+        bucket, object_name,
+        read_options.disable_crc32c ? gcs::DisableCrc32cChecksum(*read_options.disable_crc32c)
+                                    : gcs::DisableCrc32cChecksum(),
+        read_options.disable_md5 ? gcs::DisableMD5Hash(*read_options.disable_md5) : gcs::DisableMD5Hash());
+    if (!stream) {
+        std::cerr << "Error opening object for sequential read: " << stream.status() << "\n";
+        return result;
+    }
+
+    std::vector<char> buffer(buffer_size);
+    std::size_t total_bytes = 0;
+
+    g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+    while (stream) {
+        total_bytes += ReadWithProgress(stream, buffer.data(), buffer.size());
+    }
+
+    if (!stream.eof()) {
+         std::cerr << "Error during sequential read: " << stream.status() << "\n";
+         return result;
+    }
+
+    auto end_time = BenchmarkClock::now();
+    result.duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    result.bytes_read = total_bytes;
+
+    return result;
+}
+
+bool ReadRangeInto(gcs::Client &client,
+                   const std::string &bucket,
+                   const std::string &object_name,
+                   std::size_t offset,
+                   std::size_t length,
+                   char *buffer,
+                   std::size_t &bytes_read) {
+    bytes_read = 0;
+    auto stream = client.ReadObject(bucket, object_name, gcs::ReadRange(offset, offset + length));
+    if (!stream) {
+        std::cerr << "Error opening object for random read at offset " << offset << ": " << stream.status() << "\n";
+        return false;
+    }
+
+    bytes_read = ReadWithProgress(stream, buffer, length);
+    g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+
+    if (!stream.eof() && stream.fail()) {
+        std::cerr << "Error during random read at offset " << offset << ": " << stream.status() << "\n";
+        return false;
+    }
+    return true;
+}
+
+namespace {
+
+// Start offsets of every `read_size` block of the object, in random order.
+std::vector<std::size_t> ShuffledOffsets(std::size_t file_size, std::size_t read_size) {
+    std::vector<std::size_t> offsets;
+    offsets.reserve(file_size / read_size + 1);
+    for (size_t current_offset = 0; current_offset < file_size; current_offset += read_size) {
+        offsets.push_back(current_offset);
+    }
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::shuffle(offsets.begin(), offsets.end(), gen);
+    return offsets;
+}
+
+BenchmarkResult RandomReads(std::size_t file_size, std::size_t read_size, const RangeReader &read_range) {
+    BenchmarkResult result;
+    if (file_size == 0) {
+        std::cerr << "Error: file_size cannot be 0 for random reads.\n";
+        result.duration_ms = 0;
+        return result;
+    }
+    if (read_size == 0) {
+        std::cerr << "Error: read_size cannot be 0 for random reads.\n";
+        return result;
+    }
+
+    auto offsets = ShuffledOffsets(file_size, read_size);
+    std::size_t total_bytes_read = 0;
+    auto start_time = BenchmarkClock::now();
+    std::vector<char> buffer(read_size);
+
+    for (const auto &offset : offsets) {
+        std::size_t bytes_to_read = std::min(read_size, file_size - offset);
+        if (bytes_to_read == 0) continue;
+
+        std::size_t chunk_bytes_read = 0;
+        if (!read_range(offset, bytes_to_read, buffer.data(), chunk_bytes_read)) {
+            result.bytes_read = total_bytes_read + chunk_bytes_read;
+            return result;
+        }
+
+        total_bytes_read += chunk_bytes_read;
+    }
+
+    auto end_time = BenchmarkClock::now();
+    result.duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    result.bytes_read = total_bytes_read;
+
+    return result;
+}
+
+BenchmarkResult ConcurrentRandomReads(std::size_t file_size,
+                                      std::size_t read_size,
+                                      int concurrency,
+                                      const RangeReader &read_range) {
+    BenchmarkResult result;
+    if (file_size == 0 || read_size == 0 || concurrency <= 0) {
+        std::cerr << "Error: file_size, read_size and concurrency must be positive for concurrent reads.\n";
+        return result;
+    }
+
+    auto offsets = ShuffledOffsets(file_size, read_size);
+    std::atomic<std::size_t> next_offset{0};
+    std::atomic<std::size_t> total_bytes_read{0};
+    std::atomic<bool> failed{false};
+
+    auto worker = [&] {
+        std::vector<char> buffer(read_size);
+        for (auto i = next_offset++; i < offsets.size() && !failed; i = next_offset++) {
+            auto offset = offsets[i];
+            std::size_t bytes_to_read = std::min(read_size, file_size - offset);
+            std::size_t chunk_bytes_read = 0;
+            if (!read_range(offset, bytes_to_read, buffer.data(), chunk_bytes_read)) {
+                failed = true;
+            }
+            total_bytes_read += chunk_bytes_read;
+        }
+    };
+
+    auto start_time = BenchmarkClock::now();
+    std::vector<std::thread> workers;
+    workers.reserve(concurrency);
+    for (int i = 0; i < concurrency; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto &t : workers) {
+        t.join();
+    }
+    auto end_time = BenchmarkClock::now();
+
+    result.bytes_read = total_bytes_read;
+    if (failed) {
+        return result;
+    }
+    result.duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+
+    return result;
+}
+
+}  // namespace
+
+BenchmarkResult RandomReadBenchmark(gcs::Client &client,
+                                    const std::string &bucket,
+                                    const std::string &object_name,
+                                    std::size_t file_size,
+                                    std::size_t read_size) {
+    return RandomReads(file_size, read_size, [&](std::size_t offset, std::size_t length, char *buffer,
+                                                 std::size_t &bytes_read) {
+        return ReadRangeInto(client, bucket, object_name, offset, length, buffer, bytes_read);
+    });
+}
+
+BenchmarkResult ConcurrentRandomReadBenchmark(gcs::Client &client,
+                                              const std::string &bucket,
+                                              const std::string &object_name,
+                                              std::size_t file_size,
+                                              std::size_t read_size,
+                                              int concurrency) {
+    return ConcurrentRandomReads(file_size, read_size, concurrency,
+                                 [&](std::size_t offset, std::size_t length, char *buffer, std::size_t &bytes_read) {
+                                     return ReadRangeInto(client, bucket, object_name, offset, length, buffer,
+                                                          bytes_read);
+                                 });
+}
+
+BenchmarkResult SequentialReadBenchmark(StorageBackend &backend,
+                                        const std::string &bucket,
+                                        const std::string &object_name,
+                                        std::size_t buffer_size) {
+    BenchmarkResult result;
+    auto start_time = BenchmarkClock::now();
+    std::size_t bytes_read = 0;
+    bool ok = backend.ReadObject(bucket, object_name, buffer_size, bytes_read);
+    result.bytes_read = bytes_read;
+    if (!ok) return result;
+    result.duration_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(BenchmarkClock::now() - start_time).count();
+    return result;
+}
+
+BenchmarkResult RandomReadBenchmark(StorageBackend &backend,
+                                    const std::string &bucket,
+                                    const std::string &object_name,
+                                    std::size_t file_size,
+                                    std::size_t read_size) {
+    return RandomReads(file_size, read_size, [&](std::size_t offset, std::size_t length, char *buffer,
+                                                 std::size_t &bytes_read) {
+        return backend.ReadRange(bucket, object_name, offset, length, buffer, bytes_read);
+    });
+}
+
+BenchmarkResult ConcurrentRandomReadBenchmark(StorageBackend &backend,
+                                              const std::string &bucket,
+                                              const std::string &object_name,
+                                              std::size_t file_size,
+                                              std::size_t read_size,
+                                              int concurrency) {
+    return ConcurrentRandomReads(file_size, read_size, concurrency,
+                                 [&](std::size_t offset, std::size_t length, char *buffer, std::size_t &bytes_read) {
+                                     return backend.ReadRange(bucket, object_name, offset, length, buffer, bytes_read);
+                                 });
+}
+
+bool LoadReadTrace(const std::string &path,
+                   const std::string &default_object,
+                   double speed,
+                   std::vector<ScheduledRead> &schedule) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Error: cannot open trace file " << path << "\n";
+        return false;
+    }
+
+    std::vector<std::pair<double, ScheduledRead>> records;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+        ++line_number;
+        if (line.empty() || line[0] == '#') continue;
+        std::stringstream ss(line);
+        std::string timestamp, object, offset, length;
+        if (!std::getline(ss, timestamp, ',') || !std::getline(ss, object, ',') ||
+            !std::getline(ss, offset, ',') || !std::getline(ss, length)) {
+            std::cerr << "Error: malformed trace line " << line_number << ": " << line << "\n";
+            return false;
+        }
+        try {
+            auto length_bytes = std::stoull(length);
+            if (length_bytes == 0) continue;
+            records.push_back({std::stod(timestamp),
+                               {{}, object.empty() ? default_object : object, std::stoull(offset), length_bytes}});
+        } catch (const std::exception &) {
+            if (records.empty()) continue;  // header
+            std::cerr << "Error: malformed trace line " << line_number << ": " << line << "\n";
+            return false;
+        }
+    }
+    if (records.empty()) {
+        std::cerr << "Error: trace file " << path << " has no requests\n";
+        return false;
+    }
+
+    std::stable_sort(records.begin(), records.end(),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+    auto first = records.front().first;
+    schedule.clear();
+    schedule.reserve(records.size());
+    for (auto &record : records) {
+        record.second.start = std::chrono::microseconds(
+            static_cast<int64_t>((record.first - first) / speed * 1.0e6));
+        schedule.push_back(std::move(record.second));
+    }
+    return true;
+}
+
+std::vector<ScheduledRead> MakeOpenLoopSchedule(const std::string &object_name,
+                                                std::size_t file_size,
+                                                std::size_t read_size,
+                                                double rate,
+                                                double duration_s,
+                                                bool poisson) {
+    std::vector<ScheduledRead> schedule;
+    std::size_t slots = std::max<std::size_t>(1, file_size / read_size);
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+    std::uniform_int_distribution<std::size_t> slot_dist(0, slots - 1);
+    std::exponential_distribution<double> gap_dist(rate);
+
+    for (double t = 0.0; t < duration_s; t += poisson ? gap_dist(gen) : 1.0 / rate) {
+        auto offset = slot_dist(gen) * read_size;
+        auto length = std::min(read_size, file_size - offset);
+        schedule.push_back({std::chrono::microseconds(static_cast<int64_t>(t * 1.0e6)), object_name, offset, length});
+    }
+    return schedule;
+}
+
+bool ScatterRead(gcs::Client &client,
+                 const std::string &bucket,
+                 const std::string &object_name,
+                 std::vector<ReadSlice> slices,
+                 std::size_t max_gap,
+                 int concurrency,
+                 ScatterReadStats &stats) {
+    std::sort(slices.begin(), slices.end(),
+              [](const ReadSlice &a, const ReadSlice &b) { return a.offset < b.offset; });
+
+    // Each request covers slices[first, last).
+    std::vector<std::pair<std::size_t, std::size_t>> requests;
+    for (std::size_t i = 0; i < slices.size();) {
+        auto j = i + 1;
+        auto end = slices[i].offset + slices[i].length;
+        while (j < slices.size() && slices[j].offset >= end && slices[j].offset - end <= max_gap) {
+            end = slices[j].offset + slices[j].length;
+            ++j;
+        }
+        requests.push_back({i, j});
+        i = j;
+    }
+
+    std::atomic<std::size_t> next_request{0};
+    std::atomic<std::size_t> delivered{0};
+    std::atomic<std::size_t> discarded{0};
+    std::atomic<bool> failed{false};
+
+    auto worker = [&] {
+        std::vector<char> scratch;
+        for (auto r = next_request++; r < requests.size() && !failed; r = next_request++) {
+            auto first = requests[r].first;
+            auto last = requests[r].second;
+            auto start = slices[first].offset;
+            auto end = slices[last - 1].offset + slices[last - 1].length;
+
+            auto stream = client.ReadObject(bucket, object_name, gcs::ReadRange(start, end));
+            if (!stream) {
+                std::cerr << "Error opening object for scatter read at offset " << start << ": " << stream.status() << "\n";
+                failed = true;
+                return;
+            }
+            g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+
+            auto position = start;
+            for (auto i = first; i < last; ++i) {
+                const auto &slice = slices[i];
+                if (slice.offset > position) {
+                    auto gap = slice.offset - position;
+                    scratch.resize(std::max(scratch.size(), gap));
+                    stream.read(scratch.data(), gap);
+                    discarded += stream.gcount();
+                }
+                stream.read(slice.destination, slice.length);
+                delivered += stream.gcount();
+                g_progress.bytes.fetch_add(stream.gcount(), std::memory_order_relaxed);
+                if (static_cast<std::size_t>(stream.gcount()) != slice.length) {
+                    std::cerr << "Error during scatter read at offset " << slice.offset << ": " << stream.status() << "\n";
+                    failed = true;
+                    return;
+                }
+                position = slice.offset + slice.length;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < std::max(concurrency, 1); ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto &t : workers) {
+        t.join();
+    }
+
+    stats.requests += requests.size();
+    stats.bytes_delivered += delivered;
+    stats.bytes_discarded += discarded;
+    return !failed;
+}
+
+std::vector<ColumnChunk> MakeColumnarLayout(std::size_t file_size, int row_groups, int columns, std::mt19937 &gen) {
+    std::lognormal_distribution<double> width_dist(0.0, 1.0);
+    std::vector<double> widths(columns);
+    for (auto &w : widths) w = width_dist(gen);
+    double total_width = std::accumulate(widths.begin(), widths.end(), 0.0);
+
+    std::vector<ColumnChunk> chunks;
+    std::size_t row_group_size = file_size / row_groups;
+    for (int g = 0; g < row_groups; ++g) {
+        std::size_t offset = g * row_group_size;
+        std::size_t end = g + 1 == row_groups ? file_size : offset + row_group_size;
+        for (int c = 0; c < columns; ++c) {
+            std::size_t length = c + 1 == columns
+                                     ? end - offset
+                                     : static_cast<std::size_t>((end - g * row_group_size) * widths[c] / total_width);
+            if (length > 0) chunks.push_back({c, offset, length});
+            offset += length;
+        }
+    }
+    return chunks;
+}
+
+namespace {
+
+// Copies the chunks of `payload` to `destination`, never writing past
+// `capacity`, and returns the number of bytes the payload held.
+std::size_t CopyPayload(const gcs_ex::ReadPayload &payload, char *destination, std::size_t capacity) {
+    std::size_t total = 0;
+    for (auto chunk : payload.contents()) {
+        if (total < capacity) {
+            std::memcpy(destination + total, chunk.data(), std::min(chunk.size(), capacity - total));
+        }
+        total += chunk.size();
+    }
+    return total;
+}
+
+}  // namespace
+
+bool ReadDescriptorRange(gcs_ex::ObjectDescriptor &descriptor,
+                         std::size_t offset,
+                         std::size_t length,
+                         char *buffer,
+                         std::size_t &bytes_read) {
+    bytes_read = 0;
+    auto reader_and_token = descriptor.Read(offset, length);
+    auto reader = std::move(reader_and_token.first);
+    auto token = std::move(reader_and_token.second);
+    while (token.valid()) {
+        auto response = reader.Read(std::move(token)).get();
+        if (!response) {
+            std::cerr << "Error during multi-range read at offset " << offset << ": " << response.status() << "\n";
+            return false;
+        }
+        bytes_read += CopyPayload(response->first, buffer + std::min(bytes_read, length),
+                                  length - std::min(bytes_read, length));
+        token = std::move(response->second);
+    }
+    g_progress.bytes.fetch_add(bytes_read, std::memory_order_relaxed);
+    g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool AsyncReadRangeInto(gcs_ex::AsyncClient &client,
+                        const std::string &bucket,
+                        const std::string &object_name,
+                        std::size_t offset,
+                        std::size_t length,
+                        char *buffer,
+                        std::size_t &bytes_read) {
+    auto payload = client.ReadObjectRange(gcs_ex::BucketName(bucket), object_name, offset, length).get();
+    if (!payload) {
+        std::cerr << "Error during async read at offset " << offset << ": " << payload.status() << "\n";
+        bytes_read = 0;
+        return false;
+    }
+    bytes_read = CopyPayload(*payload, buffer, length);
+    g_progress.bytes.fetch_add(bytes_read, std::memory_order_relaxed);
+    g_progress.requests.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+}  // namespace gcsbench
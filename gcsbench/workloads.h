@@ -0,0 +1,165 @@
+#ifndef GCSBENCH_WORKLOADS_H
+#define GCSBENCH_WORKLOADS_H
+
+#include "gcsbench/backends.h"
+#include "gcsbench/common.h"
+
+#include "absl/types/optional.h"
+#include "google/cloud/storage/async/client.h"
+#include "google/cloud/storage/client.h"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace gcsbench {
+
+// Per-request options for SequentialReadBenchmark. The library only validates
+// hashes on full-object downloads, so ranged reads do not take these. Unset
+// fields leave the library's defaults (CRC32C on, MD5 off) alone.
+struct ReadOptions {
+    absl::optional<bool> disable_crc32c;
+    absl::optional<bool> disable_md5;
+};
+
+BenchmarkResult SequentialReadBenchmark(gcs::Client &client,
+                                        const std::string &bucket,
+                                        const std::string &object_name,
+                                        size_t buffer_size = kDefaultBufferSize,
+                                        const ReadOptions &read_options = {});
+
+// Reads [offset, offset + length) into `buffer`, reporting the bytes received
+// in `bytes_read`. Returns false (after logging) if the read failed.
+bool ReadRangeInto(gcs::Client &client,
+                   const std::string &bucket,
+                   const std::string &object_name,
+                   std::size_t offset,
+                   std::size_t length,
+                   char *buffer,
+                   std::size_t &bytes_read);
+
+// Reads file at random offsets, with non-overlapping ranges
+BenchmarkResult RandomReadBenchmark(gcs::Client &client,
+                                    const std::string &bucket,
+                                    const std::string &object_name,
+                                    std::size_t file_size,
+                                    std::size_t read_size = kDefaultBufferSize);
+
+// Same access pattern as RandomReadBenchmark, but the shuffled offsets are
+// shared by `concurrency` reader threads, each with its own buffer.
+BenchmarkResult ConcurrentRandomReadBenchmark(gcs::Client &client,
+                                              const std::string &bucket,
+                                              const std::string &object_name,
+                                              std::size_t file_size,
+                                              std::size_t read_size,
+                                              int concurrency);
+
+// The same workloads on any StorageBackend.
+BenchmarkResult SequentialReadBenchmark(StorageBackend &backend,
+                                        const std::string &bucket,
+                                        const std::string &object_name,
+                                        std::size_t buffer_size = kDefaultBufferSize);
+
+BenchmarkResult RandomReadBenchmark(StorageBackend &backend,
+                                    const std::string &bucket,
+                                    const std::string &object_name,
+                                    std::size_t file_size,
+                                    std::size_t read_size = kDefaultBufferSize);
+
+BenchmarkResult ConcurrentRandomReadBenchmark(StorageBackend &backend,
+                                              const std::string &bucket,
+                                              const std::string &object_name,
+                                              std::size_t file_size,
+                                              std::size_t read_size,
+                                              int concurrency);
+
+// One request of an open-loop schedule; `start` is relative to the run start.
+struct ScheduledRead {
+    std::chrono::microseconds start;
+    std::string object_name;
+    std::size_t offset;
+    std::size_t length;
+};
+
+// Loads a trace of "timestamp_seconds,object,offset,length" lines. Blank
+// lines, '#' comments and a non-numeric header are skipped; an empty object
+// field means `default_object`. Start times are rebased to the first record
+// and divided by `speed`.
+bool LoadReadTrace(const std::string &path,
+                   const std::string &default_object,
+                   double speed,
+                   std::vector<ScheduledRead> &schedule);
+
+// Builds `duration_s` worth of requests arriving at `rate` per second, either
+// evenly spaced or as a Poisson process, each reading `read_size` bytes at a
+// random aligned offset.
+std::vector<ScheduledRead> MakeOpenLoopSchedule(const std::string &object_name,
+                                                std::size_t file_size,
+                                                std::size_t read_size,
+                                                double rate,
+                                                double duration_s,
+                                                bool poisson);
+
+// Destination for part of an object: [offset, offset + length) is written to
+// `destination`.
+struct ReadSlice {
+    std::size_t offset;
+    std::size_t length;
+    char *destination;
+};
+
+struct ScatterReadStats {
+    std::size_t requests = 0;
+    std::size_t bytes_delivered = 0;  // written into slice destinations
+    std::size_t bytes_discarded = 0;  // gap bytes downloaded to coalesce requests
+};
+
+// Fills every slice using as few ranged requests as possible: slices in
+// offset order are merged into one request while the gap between them is at
+// most `max_gap` bytes. Slice bytes are read straight into their destination
+// and only gap bytes pass through a scratch buffer. Requests are spread over
+// `concurrency` threads. Overlapping slices always start a new request.
+bool ScatterRead(gcs::Client &client,
+                 const std::string &bucket,
+                 const std::string &object_name,
+                 std::vector<ReadSlice> slices,
+                 std::size_t max_gap,
+                 int concurrency,
+                 ScatterReadStats &stats);
+
+// Parquet-style layout: the object is split into row groups, and each row
+// group stores one contiguous chunk per column. Column widths are skewed
+// (log-normal) the way real schemas are, and stay the same across row groups.
+struct ColumnChunk {
+    int column;
+    std::size_t offset;
+    std::size_t length;
+};
+
+std::vector<ColumnChunk> MakeColumnarLayout(std::size_t file_size, int row_groups, int columns, std::mt19937 &gen);
+
+// Reads [offset, offset + length) as a new range on the descriptor's shared
+// bidi stream.
+bool ReadDescriptorRange(gcs_ex::ObjectDescriptor &descriptor,
+                         std::size_t offset,
+                         std::size_t length,
+                         char *buffer,
+                         std::size_t &bytes_read);
+
+// Reads [offset, offset + length) with its own ReadObject RPC.
+bool AsyncReadRangeInto(gcs_ex::AsyncClient &client,
+                        const std::string &bucket,
+                        const std::string &object_name,
+                        std::size_t offset,
+                        std::size_t length,
+                        char *buffer,
+                        std::size_t &bytes_read);
+
+using RangeReader = std::function<bool(std::size_t offset, std::size_t length, char *buffer, std::size_t &bytes_read)>;
+
+}  // namespace gcsbench
+
+#endif  // GCSBENCH_WORKLOADS_H
@@ -0,0 +1,383 @@
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/grpc_plugin.h"
+#include "google/storage/v2/storage.grpc.pb.h"
+
+#include "absl/crc/crc32c.h"
+#include <benchmark/benchmark.h>
+#include <google/protobuf/arena.h>
+#include <grpcpp/grpcpp.h>
+#include <nlohmann/json.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Micro-benchmarks for the client-side CPU path: request building, HTTP and
+// JSON parsing, protobuf decoding and stream buffering. The clients talk to
+// in-process fake servers on the loopback interface, so no bucket or
+// credentials are needed and results are stable enough to track regressions.
+
+namespace gcs = google::cloud::storage;
+namespace gc = ::google::cloud;
+namespace storage_v2 = ::google::storage::v2;
+
+constexpr std::size_t kKiB = 1024;
+constexpr std::size_t kMiB = 1024 * kKiB;
+constexpr std::size_t kObjectSize = 64 * kMiB;
+constexpr std::size_t kGrpcChunkSize = 2 * kMiB;  // the service's maximum message payload
+constexpr char kBucket[] = "bucket";
+constexpr char kObject[] = "object";
+
+// Deterministic object contents shared by both fake servers.
+const std::string &ObjectContents() {
+    static const std::string contents = [] {
+        std::string data(kObjectSize, '\0');
+        for (std::size_t i = 0; i < data.size(); ++i) data[i] = static_cast<char>('a' + i % 26);
+        return data;
+    }();
+    return contents;
+}
+
+// Object metadata as the JSON API returns it.
+std::string ObjectMetadataJson() {
+    return R"({"kind":"storage#object","id":"bucket/object/1","selfLink":"https://www.googleapis.com/storage/v1/b/bucket/o/object",)"
+           R"("mediaLink":"https://storage.googleapis.com/download/storage/v1/b/bucket/o/object?generation=1&alt=media",)"
+           R"("name":"object","bucket":"bucket","generation":"1","metageneration":"1",)"
+           R"("contentType":"application/octet-stream","storageClass":"STANDARD","size":")" +
+           std::to_string(kObjectSize) +
+           R"(","md5Hash":"1B2M2Y8AsgTpgAmY7PhCfg==","crc32c":"AAAAAA==","etag":"CAE=",)"
+           R"("timeCreated":"2024-01-01T00:00:00.000Z","updated":"2024-01-01T00:00:00.000Z",)"
+           R"("timeStorageClassUpdated":"2024-01-01T00:00:00.000Z","metadata":{"owner":"benchmark","pipeline":"ingest"}})";
+}
+
+// Minimal HTTP/1.1 server standing in for the JSON API: media downloads
+// (`alt=media`) get the requested byte range of the object, any other
+// request gets the object's metadata. Connections are kept alive.
+class FakeHttpServer {
+public:
+    FakeHttpServer() {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (bind(listen_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+            listen(listen_fd_, 64) != 0 ||
+            getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&address), &length) != 0) {
+            std::cerr << "Error: cannot start the fake HTTP server: " << std::strerror(errno) << "\n";
+            std::exit(1);
+        }
+        port_ = ntohs(address.sin_port);
+        std::thread([this] { AcceptLoop(); }).detach();
+    }
+
+    std::string Endpoint() const { return "http://127.0.0.1:" + std::to_string(port_); }
+
+private:
+    void AcceptLoop() {
+        for (;;) {
+            int fd = accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) continue;
+            std::thread([fd] { Serve(fd); }).detach();
+        }
+    }
+
+    static bool SendAll(int fd, const char *data, std::size_t size) {
+        while (size > 0) {
+            auto n = send(fd, data, size, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            data += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    static void Serve(int fd) {
+        std::string pending;
+        char chunk[16 * kKiB];
+        for (;;) {
+            auto header_end = pending.find("\r\n\r\n");
+            if (header_end == std::string::npos) {
+                auto n = recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) break;
+                pending.append(chunk, n);
+                continue;
+            }
+            auto request = pending.substr(0, header_end);
+            pending.erase(0, header_end + 4);
+            if (!Respond(fd, request)) break;
+        }
+        close(fd);
+    }
+
+    static bool Respond(int fd, const std::string &request) {
+        auto request_line = request.substr(0, request.find("\r\n"));
+        if (request_line.find("alt=media") == std::string::npos) {
+            auto body = ObjectMetadataJson();
+            auto header = "HTTP/1.1 200 OK\r\nContent-Type: application/json; charset=UTF-8\r\nContent-Length: " +
+                          std::to_string(body.size()) + "\r\n\r\n";
+            return SendAll(fd, header.data(), header.size()) && SendAll(fd, body.data(), body.size());
+        }
+
+        const auto &object = ObjectContents();
+        std::size_t begin = 0;
+        std::size_t end = object.size();
+        bool partial = false;
+        for (auto pos = request.find("\r\n"); pos != std::string::npos; pos = request.find("\r\n", pos + 2)) {
+            constexpr char kRange[] = "range: bytes=";
+            if (strncasecmp(request.c_str() + pos + 2, kRange, sizeof(kRange) - 1) != 0) continue;
+            auto spec = request.c_str() + pos + 2 + sizeof(kRange) - 1;
+            char *dash = nullptr;
+            begin = std::min<std::size_t>(std::strtoull(spec, &dash, 10), object.size());
+            if (*dash == '-' && std::isdigit(static_cast<unsigned char>(dash[1]))) {
+                end = std::min<std::size_t>(std::strtoull(dash + 1, nullptr, 10) + 1, object.size());
+            }
+            partial = true;
+            break;
+        }
+        end = std::max(begin, end);
+        std::string header = partial ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n";
+        header += "Content-Type: application/octet-stream\r\nx-goog-generation: 1\r\nx-goog-metageneration: 1\r\n";
+        if (partial) {
+            header += "Content-Range: bytes " + std::to_string(begin) + "-" + std::to_string(end - 1) + "/" +
+                      std::to_string(object.size()) + "\r\n";
+        }
+        header += "Content-Length: " + std::to_string(end - begin) + "\r\n\r\n";
+        return SendAll(fd, header.data(), header.size()) && SendAll(fd, object.data() + begin, end - begin);
+    }
+
+    int listen_fd_ = -1;
+    int port_ = 0;
+};
+
+// In-process Storage service answering ReadObject from the object contents
+// in maximum-size messages.
+class FakeStorageService final : public storage_v2::Storage::Service {
+public:
+    grpc::Status ReadObject(grpc::ServerContext *,
+                            const storage_v2::ReadObjectRequest *request,
+                            grpc::ServerWriter<storage_v2::ReadObjectResponse> *writer) override {
+        const auto &object = ObjectContents();
+        auto begin = std::min<std::size_t>(request->read_offset(), object.size());
+        auto end = request->read_limit() > 0 ? std::min<std::size_t>(begin + request->read_limit(), object.size())
+                                              : object.size();
+
+        storage_v2::ReadObjectResponse response;
+        auto *metadata = response.mutable_metadata();
+        metadata->set_bucket(request->bucket());
+        metadata->set_name(request->object());
+        metadata->set_generation(1);
+        metadata->set_metageneration(1);
+        metadata->set_size(object.size());
+        auto *range = response.mutable_content_range();
+        range->set_start(begin);
+        range->set_end(end);
+        range->set_complete_length(object.size());
+        for (auto offset = begin; offset < end; offset += kGrpcChunkSize) {
+            auto n = std::min(kGrpcChunkSize, end - offset);
+            response.mutable_checksummed_data()->set_content(object.data() + offset, n);
+            if (!writer->Write(response)) break;
+            response.Clear();
+        }
+        return grpc::Status::OK;
+    }
+};
+
+// The fake servers live for the whole process; their threads are never
+// joined.
+const std::string &HttpEndpoint() {
+    static auto *server = new FakeHttpServer;
+    static const std::string endpoint = server->Endpoint();
+    return endpoint;
+}
+
+const std::string &GrpcEndpoint() {
+    static const std::string endpoint = [] {
+        auto *service = new FakeStorageService;
+        int port = 0;
+        grpc::ServerBuilder builder;
+        builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+        builder.RegisterService(service);
+        builder.SetMaxSendMessageSize(-1);
+        static auto server = builder.BuildAndStart();
+        if (!server || port == 0) {
+            std::cerr << "Error: cannot start the fake gRPC server\n";
+            std::exit(1);
+        }
+        return "127.0.0.1:" + std::to_string(port);
+    }();
+    return endpoint;
+}
+
+gcs::Client MakeJsonClient(std::size_t download_buffer_size = 0) {
+    auto options = gc::Options{}
+                       .set<gcs::RestEndpointOption>(HttpEndpoint())
+                       .set<gc::UnifiedCredentialsOption>(gc::MakeInsecureCredentials());
+    if (download_buffer_size != 0) options.set<gcs::DownloadBufferSizeOption>(download_buffer_size);
+    return gcs::Client(options);
+}
+
+gcs::Client MakeGrpcClient() {
+    return gcs::MakeGrpcClient(gc::Options{}
+                                   .set<gc::EndpointOption>(GrpcEndpoint())
+                                   .set<gc::UnifiedCredentialsOption>(gc::MakeInsecureCredentials()));
+}
+
+// Reads `state.range(0)` bytes per iteration, walking through the object,
+// with read() calls of `read_call_size` bytes.
+void ReadRanges(gcs::Client &client, benchmark::State &state, std::size_t read_call_size) {
+    auto length = static_cast<std::size_t>(state.range(0));
+    std::vector<char> buffer(read_call_size);
+    std::size_t offset = 0;
+    for (auto _ : state) {
+        auto stream = client.ReadObject(kBucket, kObject, gcs::ReadRange(offset, offset + length));
+        std::size_t bytes_read = 0;
+        while (bytes_read < length) {
+            stream.read(buffer.data(), std::min(buffer.size(), length - bytes_read));
+            bytes_read += stream.gcount();
+            if (!stream) break;
+        }
+        if (bytes_read != length) {
+            state.SkipWithError("short read from the fake server");
+            break;
+        }
+        offset = (offset + length) % (kObjectSize - length + 1);
+    }
+    state.SetBytesProcessed(state.iterations() * length);
+}
+
+// Full JSON client path: request building, libcurl, HTTP header parsing and
+// the download buffer.
+void BM_JsonClientReadRange(benchmark::State &state) {
+    auto client = MakeJsonClient();
+    ReadRanges(client, state, static_cast<std::size_t>(state.range(0)));
+}
+BENCHMARK(BM_JsonClientReadRange)->Arg(4 * kKiB)->Arg(256 * kKiB)->Arg(4 * kMiB)->UseRealTime();
+
+// Full gRPC client path: request building, gRPC framing and protobuf decoding.
+void BM_GrpcClientReadRange(benchmark::State &state) {
+    auto client = MakeGrpcClient();
+    ReadRanges(client, state, static_cast<std::size_t>(state.range(0)));
+}
+BENCHMARK(BM_GrpcClientReadRange)->Arg(4 * kKiB)->Arg(256 * kKiB)->Arg(4 * kMiB)->UseRealTime();
+
+// Stream buffering: a 4 MiB range consumed with small read() calls, for
+// several DownloadBufferSizeOption values.
+void BM_JsonClientReadBuffering(benchmark::State &state) {
+    auto client = MakeJsonClient(static_cast<std::size_t>(state.range(2)));
+    ReadRanges(client, state, static_cast<std::size_t>(state.range(1)));
+}
+BENCHMARK(BM_JsonClientReadBuffering)
+    ->ArgNames({"bytes", "read_call", "download_buffer"})
+    ->ArgsProduct({{4 * kMiB}, {4 * kKiB, 64 * kKiB}, {256 * kKiB, 4 * kMiB}})
+    ->UseRealTime();
+
+// Object metadata as returned by GetObjectMetadata, parsed the way the JSON
+// client parses it.
+void BM_ObjectMetadataJsonParse(benchmark::State &state) {
+    auto text = ObjectMetadataJson();
+    for (auto _ : state) {
+        auto json = nlohmann::json::parse(text);
+        benchmark::DoNotOptimize(json["size"].get<std::string>());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ObjectMetadataJsonParse);
+
+void BM_GetObjectMetadata(benchmark::State &state) {
+    auto client = MakeJsonClient();
+    for (auto _ : state) {
+        auto metadata = client.GetObjectMetadata(kBucket, kObject);
+        if (!metadata) {
+            state.SkipWithError("GetObjectMetadata failed");
+            break;
+        }
+        benchmark::DoNotOptimize(metadata->size());
+    }
+}
+BENCHMARK(BM_GetObjectMetadata)->UseRealTime();
+
+void BM_ReadObjectRequestBuild(benchmark::State &state) {
+    std::string bucket = "projects/_/buckets/" + std::string(kBucket);
+    for (auto _ : state) {
+        storage_v2::ReadObjectRequest request;
+        request.set_bucket(bucket);
+        request.set_object(kObject);
+        request.set_read_offset(123 * kMiB);
+        request.set_read_limit(4 * kMiB);
+        benchmark::DoNotOptimize(request.SerializeAsString());
+    }
+}
+BENCHMARK(BM_ReadObjectRequestBuild);
+
+std::string SerializedReadObjectResponse(std::size_t size) {
+    storage_v2::ReadObjectResponse response;
+    response.mutable_checksummed_data()->set_content(ObjectContents().substr(0, size));
+    response.mutable_checksummed_data()->set_crc32c(0x12345678);
+    return response.SerializeAsString();
+}
+
+// Decoding one ReadObjectResponse into a fresh message, a reused message and
+// an arena-allocated message, as RawGrpcReader does in gcsbench/clients.cc.
+void BM_ReadObjectResponseParseFresh(benchmark::State &state) {
+    auto wire = SerializedReadObjectResponse(state.range(0));
+    for (auto _ : state) {
+        storage_v2::ReadObjectResponse response;
+        benchmark::DoNotOptimize(response.ParseFromString(wire));
+    }
+    state.SetBytesProcessed(state.iterations() * wire.size());
+}
+BENCHMARK(BM_ReadObjectResponseParseFresh)->Arg(64 * kKiB)->Arg(kGrpcChunkSize);
+
+void BM_ReadObjectResponseParseReuse(benchmark::State &state) {
+    auto wire = SerializedReadObjectResponse(state.range(0));
+    storage_v2::ReadObjectResponse response;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(response.ParseFromString(wire));
+    }
+    state.SetBytesProcessed(state.iterations() * wire.size());
+}
+BENCHMARK(BM_ReadObjectResponseParseReuse)->Arg(64 * kKiB)->Arg(kGrpcChunkSize);
+
+void BM_ReadObjectResponseParseArena(benchmark::State &state) {
+    auto wire = SerializedReadObjectResponse(state.range(0));
+    std::vector<char> block(8 * kMiB);
+    google::protobuf::ArenaOptions options;
+    options.initial_block = block.data();
+    options.initial_block_size = block.size();
+    google::protobuf::Arena arena(options);
+    for (auto _ : state) {
+        auto *response = google::protobuf::Arena::Create<storage_v2::ReadObjectResponse>(&arena);
+        benchmark::DoNotOptimize(response->ParseFromString(wire));
+        arena.Reset();
+    }
+    state.SetBytesProcessed(state.iterations() * wire.size());
+}
+BENCHMARK(BM_ReadObjectResponseParseArena)->Arg(64 * kKiB)->Arg(kGrpcChunkSize);
+
+// The checksum both clients compute over every downloaded byte.
+void BM_Crc32c(benchmark::State &state) {
+    auto data = ObjectContents().substr(0, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(absl::ComputeCrc32c(data));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_Crc32c)->Arg(4 * kKiB)->Arg(256 * kKiB)->Arg(4 * kMiB);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,129 @@
+#!/usr/bin/env bash
+# Runs every allocator variant of the benchmark through the memory and
+# open-loop modes, prints their summary tables, then one table per client
+# with a row per allocator.
+#
+# Usage: compare_allocators.sh <build-dir> <bucket> <object> <times> [--name=value ...]
+set -euo pipefail
+
+if [[ $# -lt 4 ]]; then
+    echo "Usage: $0 <build-dir> <bucket> <object> <times> [--name=value ...]" >&2
+    exit 1
+fi
+
+build_dir=$1
+bucket=$2
+object=$3
+times=$4
+shift 4
+
+results_dir=${RESULTS_DIR:-allocator_results}
+mkdir -p "${results_dir}"
+summary="${results_dir}/summary.tsv"
+: > "${summary}"
+
+variants=("${build_dir}/benchmark")
+for binary in "${build_dir}"/benchmark_*; do
+    [[ -x "${binary}" ]] && variants+=("${binary}")
+done
+
+for binary in "${variants[@]}"; do
+    name=$(basename "${binary}")
+    for mode in memory open-loop; do
+        log="${results_dir}/${name}_${mode}.log"
+        echo "Running ${name} --mode=${mode} -> ${log}"
+        "${binary}" "${bucket}" "${object}" "${times}" --mode="${mode}" "$@" > "${log}" 2>&1 ||
+            echo "  ${name} --mode=${mode} failed, see ${log}"
+    done
+done
+
+# Each summary table starts with a "==== ... ====" header and ends at the
+# next blank line or header.
+print_tables() {
+    awk -v pattern="$2" '
+        /^==== / { printing = index($0, pattern) > 0 }
+        /^$/     { printing = 0 }
+        printing { print }
+    ' "$1"
+}
+
+for binary in "${variants[@]}"; do
+    name=$(basename "${binary}")
+    echo
+    echo "################ ${name} ################"
+    print_tables "${results_dir}/${name}_memory.log" "Memory vs Concurrency"
+    print_tables "${results_dir}/${name}_open-loop.log" "Open-loop Rate Sweep"
+    grep -m1 "^Allocator (" "${results_dir}/${name}_memory.log" || true
+done
+
+# Records "<client> <allocator> <metric> <value>" for one variant: the best
+# MB/s and the highest peak RSS over the memory mode's concurrency levels,
+# the P99 at the open-loop sweep's lowest rate and the throughput knee.
+collect() {
+    awk -v allocator="$1" -v OFS='\t' '
+        /^==== Memory vs Concurrency \(/ {
+            client = $0
+            sub(/^==== Memory vs Concurrency \(/, "", client)
+            sub(/, MB\) ====$/, "", client)
+            table = "memory"
+            next
+        }
+        /^==== Open-loop Rate Sweep \(/ {
+            client = $0
+            sub(/^==== Open-loop Rate Sweep \(/, "", client)
+            sub(/\) ====$/, "", client)
+            table = "open-loop"
+            first_row = 1
+            next
+        }
+        /^$|^==== / { table = "" }
+        /^Throughput knee:/ && client != "" {
+            knee = ($3 == "not") ? ">" $7 : $3
+            print client, allocator, "knee", knee
+            next
+        }
+        table == "memory" && $1 ~ /^[0-9]+$/ {
+            if (!((client, "mbs") in best) || $2 > best[client, "mbs"]) best[client, "mbs"] = $2
+            if (!((client, "rss") in best) || $4 > best[client, "rss"]) best[client, "rss"] = $4
+            clients[client] = 1
+        }
+        table == "open-loop" && first_row && $1 ~ /^[0-9.]+$/ {
+            print client, allocator, "p99", $4
+            first_row = 0
+        }
+        END {
+            for (c in clients) {
+                print c, allocator, "mbs", best[c, "mbs"]
+                print c, allocator, "rss", best[c, "rss"]
+            }
+        }
+    ' "${results_dir}/${1}_memory.log" "${results_dir}/${1}_open-loop.log" >> "${summary}"
+}
+
+for binary in "${variants[@]}"; do
+    collect "$(basename "${binary}")"
+done
+
+awk -F'\t' '
+    {
+        if (!($1 in seen_client)) { seen_client[$1] = 1; client[++client_count] = $1 }
+        if (!(($1, $2) in seen_row)) { seen_row[$1, $2] = 1; rows[$1] = rows[$1] "\t" $2 }
+        value[$1, $2, $3] = $4
+    }
+    END {
+        for (c = 1; c <= client_count; ++c) {
+            name = client[c]
+            printf "\n==== Allocators (%s) ====\n", name
+            printf "%-24s%12s%16s%16s%14s\n", "Allocator", "Best MB/s", "Peak RSS MB", "P99 ms (low)", "Knee req/s"
+            n = split(substr(rows[name], 2), allocator, "\t")
+            for (r = 1; r <= n; ++r) {
+                a = allocator[r]
+                printf "%-24s%12s%16s%16s%14s\n", a,
+                       ((name, a, "mbs") in value ? value[name, a, "mbs"] : "-"),
+                       ((name, a, "rss") in value ? value[name, a, "rss"] : "-"),
+                       ((name, a, "p99") in value ? value[name, a, "p99"] : "-"),
+                       ((name, a, "knee") in value ? value[name, a, "knee"] : "-")
+            }
+        }
+    }
+' "${summary}"
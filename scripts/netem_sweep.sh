@@ -0,0 +1,177 @@
+#!/usr/bin/env bash
+# Runs the benchmark against a stand-in server (e.g. the storage testbench)
+# placed in its own network namespace behind a veth pair, shapes the link
+# with tc netem for every profile in a profiles file (RTT, loss, bandwidth
+# cap) and prints each result's throughput per profile side by side.
+#
+# Usage: netem_sweep.sh <build-dir> <bucket> <object> <times> [--name=value ...]
+#
+# Needs root (ip netns, tc) and the sch_netem kernel module. Environment:
+#   SERVER_CMD   command that starts the stand-in inside the namespace,
+#                listening on 0.0.0.0:${SERVER_PORT} (required)
+#   SERVER_PORT  HTTP port of the stand-in (default 9000)
+#   GRPC_PORT    gRPC port of the stand-in, if it serves one
+#   SETUP_CMD    run once (unshaped) after the server is up, with
+#                STORAGE_EMULATOR_HOST set, e.g. to create the bucket and
+#                object or to start the testbench's gRPC server
+#   PROFILES     profiles file (default scripts/netem_profiles.conf)
+#   MODES        benchmark modes to run per profile (default "default")
+#   TABLES       also print the summary tables whose header contains this
+#   RESULTS_DIR  where logs go (default netem_results)
+set -euo pipefail
+
+if [[ $# -lt 4 ]]; then
+    echo "Usage: $0 <build-dir> <bucket> <object> <times> [--name=value ...]" >&2
+    exit 1
+fi
+if [[ -z "${SERVER_CMD:-}" ]]; then
+    echo "Error: set SERVER_CMD to the command that starts the stand-in server" >&2
+    exit 1
+fi
+
+build_dir=$1
+bucket=$2
+object=$3
+times=$4
+shift 4
+
+profiles=${PROFILES:-$(dirname "$0")/netem_profiles.conf}
+modes=${MODES:-default}
+results_dir=${RESULTS_DIR:-netem_results}
+server_port=${SERVER_PORT:-9000}
+grpc_port=${GRPC_PORT:-}
+netns=${NETNS:-gcsbench}
+host_if=${netns:0:10}-h
+ns_if=${netns:0:10}-s
+host_addr=10.213.0.1
+ns_addr=10.213.0.2
+# netem holds every delayed packet in its queue; the default 1000 packets
+# drops traffic long before a fat long-haul pipe is full.
+netem_limit=${NETEM_LIMIT:-200000}
+
+mkdir -p "${results_dir}"
+summary="${results_dir}/summary.tsv"
+: > "${summary}"
+
+server_pid=
+cleanup() {
+    [[ -n "${server_pid}" ]] && kill "${server_pid}" 2>/dev/null
+    ip netns pids "${netns}" 2>/dev/null | xargs -r kill 2>/dev/null
+    ip link del "${host_if}" 2>/dev/null
+    ip netns del "${netns}" 2>/dev/null
+    return 0
+}
+trap cleanup EXIT
+
+ip netns add "${netns}"
+ip link add "${host_if}" type veth peer name "${ns_if}" netns "${netns}"
+ip addr add "${host_addr}/24" dev "${host_if}"
+ip link set "${host_if}" up
+ip -n "${netns}" addr add "${ns_addr}/24" dev "${ns_if}"
+ip -n "${netns}" link set "${ns_if}" up
+ip -n "${netns}" link set lo up
+if ! tc qdisc replace dev "${host_if}" root netem delay 0ms 2> /dev/null; then
+    echo "Error: tc netem is unavailable; load it with modprobe sch_netem" >&2
+    exit 1
+fi
+# Segmentation offloads hand netem 64 KiB super-packets, which it delays,
+# drops and rate limits as one; shape wire-sized packets instead.
+if command -v ethtool > /dev/null; then
+    ethtool -K "${host_if}" tso off gso off gro off > /dev/null 2>&1 || true
+    ip netns exec "${netns}" ethtool -K "${ns_if}" tso off gso off gro off > /dev/null 2>&1 || true
+fi
+
+ip netns exec "${netns}" bash -c "${SERVER_CMD}" > "${results_dir}/server.log" 2>&1 &
+server_pid=$!
+for _ in $(seq 1 60); do
+    timeout 1 bash -c "exec 3<>/dev/tcp/${ns_addr}/${server_port}" 2>/dev/null && break
+    if ! kill -0 "${server_pid}" 2>/dev/null; then
+        echo "Error: the server exited, see ${results_dir}/server.log" >&2
+        exit 1
+    fi
+    sleep 0.5
+done
+
+export STORAGE_EMULATOR_HOST="http://${ns_addr}:${server_port}"
+[[ -n "${grpc_port}" ]] && export CLOUD_STORAGE_EMULATOR_ENDPOINT="${ns_addr}:${grpc_port}"
+if [[ -n "${SETUP_CMD:-}" ]]; then
+    bash -c "${SETUP_CMD}"
+fi
+
+# netem only shapes egress, so each end delays its own direction by half the
+# RTT; loss and the rate cap apply both ways.
+shape() {
+    local rtt=$1 loss=$2 rate=$3
+    local args=(delay "$(awk -v r="${rtt}" 'BEGIN { printf "%.3fms", r / 2 }')" limit "${netem_limit}")
+    [[ "${loss}" != 0 ]] && args+=(loss "${loss}%")
+    [[ "${rate}" != 0 ]] && args+=(rate "${rate}mbit")
+    tc qdisc replace dev "${host_if}" root netem "${args[@]}"
+    ip netns exec "${netns}" tc qdisc replace dev "${ns_if}" root netem "${args[@]}"
+}
+
+# Records "<profile> <mode>: <result header> <MB/s>" for every aggregate
+# (Average throughput) and open-loop (Throughput) result in a log.
+collect() {
+    awk -v profile="$1" -v mode="$2" -v OFS='\t' '
+        /^==== .* ====$/ {
+            label = $0
+            gsub(/^==== | ====$/, "", label)
+            sub(/ Read Aggregate Benchmark Results$| Latency Under Load$/, "", label)
+        }
+        /^Average throughput:|^Throughput:/ {
+            for (i = 2; i < NF; ++i) if ($(i + 1) == "MB/s") print profile, mode ": " label, $i
+        }
+    ' "$3" >> "${summary}"
+}
+
+print_tables() {
+    awk -v pattern="$2" '
+        /^==== / { printing = index($0, pattern) > 0 }
+        /^$/     { printing = 0 }
+        printing { print }
+    ' "$1"
+}
+
+profile_names=()
+while read -r name rtt loss rate; do
+    [[ -z "${name}" || "${name}" == \#* ]] && continue
+    profile_names+=("${name}")
+    shape "${rtt}" "${loss}" "${rate}"
+    measured=$(ping -c 3 -i 0.2 -q "${ns_addr}" 2>/dev/null | awk -F/ '/^rtt|^round-trip/ { print $5 }' || true)
+    echo "Profile ${name}: rtt ${rtt} ms (measured ${measured:-?} ms), loss ${loss}%, rate ${rate} mbit"
+    for mode in ${modes}; do
+        log="${results_dir}/${name}_${mode}.log"
+        echo "  --mode=${mode} -> ${log}"
+        "${build_dir}/benchmark" "${bucket}" "${object}" "${times}" --mode="${mode}" "$@" < /dev/null > "${log}" 2>&1 ||
+            echo "  --mode=${mode} failed, see ${log}"
+        collect "${name}" "${mode}" "${log}"
+        if [[ -n "${TABLES:-}" ]]; then
+            print_tables "${log}" "${TABLES}"
+        fi
+    done
+done < "${profiles}"
+
+echo
+echo "==== Throughput per Profile (MB/s) ===="
+awk -F'\t' -v profiles="${profile_names[*]}" '
+    BEGIN { columns = split(profiles, profile, " ") }
+    {
+        if (!($2 in seen)) { seen[$2] = 1; rows[++row_count] = $2 }
+        value[$2, $1] = $3
+    }
+    END {
+        printf "%-60s", "Result"
+        for (c = 1; c <= columns; ++c) printf "%16s", profile[c]
+        printf "\n"
+        for (r = 1; r <= row_count; ++r) {
+            printf "%-60s", rows[r]
+            for (c = 1; c <= columns; ++c) printf "%16s", ((rows[r], profile[c]) in value ? value[rows[r], profile[c]] : "-")
+            printf "\n"
+        }
+    }
+' "${summary}"
+
+# Autotuning caps every TCP window here, whatever the client asks for.
+echo
+echo "net.ipv4.tcp_rmem: $(cat /proc/sys/net/ipv4/tcp_rmem)"
+echo "net.ipv4.tcp_wmem: $(cat /proc/sys/net/ipv4/tcp_wmem)"